@@ -0,0 +1,24 @@
+# fonts.spec : fonts the framework Makefile builds into emulator/fs
+#
+# FONTS lists the fonts, each font <name> then has
+#   <name>_FACE     TTF/OTF file the glyphs are rendered from
+#   <name>_SIZES    comma separated pixel sizes, as passed to OpenFont
+#   <name>_CHARSET  characters in FontGenCmd -c form, printable ASCII if empty
+#   <name>_ARGS     any other FontGenCmd options
+#
+# make fonts, and so make debug and make release, writes each font to
+# emulator/fs/<name>.fon and rebuilds it when its face file, any of its
+# settings or FontGenCmd change.  The face files are not in the tree, they
+# are looked for in FONT_FACES and a font whose face is not there is
+# skipped.  make FONT_FACES=<dir> to use another folder.  The fonts are
+# compressed with FONT_CODEC, xpress by default as the runtime reads.  Only
+# the Windows build of FontGenCmd has xpress, elsewhere the fonts are
+# skipped with one message unless FONT_CODEC names another codec.
+
+FONTS = neo
+
+# the widget labels, numerals and rollers
+neo_FACE = $(FONT_FACES)/neo.ttf
+neo_SIZES = 9,12,15
+neo_CHARSET =
+neo_ARGS =
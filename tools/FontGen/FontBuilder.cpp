@@ -0,0 +1,2639 @@
+// FontBuilder.cpp : UI-free raster font generator
+//
+
+#if defined(_WIN32)
+#include <windows.h>
+#endif
+
+#include <ctype.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <memory>
+
+#include "FontBuilder.h"
+#include "FontCodec.h"
+#include "FontRasterizer.h"
+#include "FontReader.h"
+#include "GlyphCache.h"
+#include "WorkerPool.h"
+
+static const char *defaultCharSet = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789!\"#$%&'(){}*+-,./\\[]^_`:;<=>?@~| ";
+
+const char *FontParams::DefaultCharSet()
+  {
+  return defaultCharSet;
+  }
+
+// value of the hex digits of str[pos] to str[end]
+static uint32_t HexValue(const std::string &str, size_t pos, size_t end)
+  {
+  uint32_t value = 0;
+  for(; pos < end; pos++)
+    {
+    char digit = str[pos];
+    value = (value << 4) | (uint32_t)(isdigit((uint8_t) digit) ? digit - '0' : (tolower(digit) - 'a' + 10));
+    }
+
+  return value;
+  }
+
+// read a code point escape, U+XXXX with exactly four hex digits or
+// U+{X} with one to six.  The digits are not read greedily so hex letters
+// can follow an escape, U+00B0ABC is the degree sign then ABC.  Returns
+// the characters used, 0 if there is no escape and -1 if a U+{ is not a
+// closed run of hex digits
+static int ParseCodePoint(const std::string &str, size_t pos, uint32_t &ch)
+  {
+  if(pos + 2 >= str.length() || (str[pos] != 'U' && str[pos] != 'u') || str[pos + 1] != '+')
+    return 0;
+
+  size_t digits = pos + 2;
+  if(str[digits] == '{')
+    {
+    size_t end = ++digits;
+    while(end < str.length() && end - digits < 6 && isxdigit((uint8_t) str[end]))
+      end++;
+
+    if(end == digits || end >= str.length() || str[end] != '}')
+      return -1;
+
+    ch = HexValue(str, digits, end);
+    return (int)(end + 1 - pos);
+    }
+
+  for(size_t i = 0; i < 4; i++)
+    if(digits + i >= str.length() || !isxdigit((uint8_t) str[digits + i]))
+      return 0;
+
+  ch = HexValue(str, digits, digits + 4);
+  return 6;
+  }
+
+// read one UTF-8 encoded character, returns the bytes used or 0 if the
+// sequence is not valid
+static size_t ParseUtf8(const std::string &str, size_t pos, uint32_t &ch)
+  {
+  uint8_t lead = (uint8_t) str[pos];
+  size_t len;
+  uint32_t min;
+
+  if(lead < 0x80)
+    {
+    ch = lead;
+    return 1;
+    }
+  else if((lead & 0xE0) == 0xC0)
+    {
+    len = 2;
+    min = 0x80;
+    ch = lead & 0x1F;
+    }
+  else if((lead & 0xF0) == 0xE0)
+    {
+    len = 3;
+    min = 0x800;
+    ch = lead & 0x0F;
+    }
+  else if((lead & 0xF8) == 0xF0)
+    {
+    len = 4;
+    min = 0x10000;
+    ch = lead & 0x07;
+    }
+  else
+    return 0;
+
+  if(pos + len > str.length())
+    return 0;
+
+  for(size_t i = 1; i < len; i++)
+    {
+    uint8_t cont = (uint8_t) str[pos + i];
+    if((cont & 0xC0) != 0x80)
+      return 0;
+
+    ch = (ch << 6) | (cont & 0x3F);
+    }
+
+  // overlong forms and surrogates are not characters
+  if(ch < min || (ch >= 0xD800 && ch <= 0xDFFF))
+    return 0;
+
+  return len;
+  }
+
+bool FontParams::ParseCharSet(const std::string &charSet, std::vector<uint32_t> &chars, std::string &error)
+  {
+  chars.clear();
+
+  for(size_t pos = 0; pos < charSet.length(); )
+    {
+    uint32_t first;
+    uint32_t last;
+    int escape = ParseCodePoint(charSet, pos, first);
+    if(escape > 0)
+      {
+      pos += escape;
+      last = first;
+
+      // U+XXXX-U+YYYY is a range
+      if(pos < charSet.length() && charSet[pos] == '-')
+        {
+        int rangeEnd = ParseCodePoint(charSet, pos + 1, last);
+        if(rangeEnd > 0)
+          pos += rangeEnd + 1;
+        else if(rangeEnd < 0)
+          escape = rangeEnd;
+        }
+      }
+
+    if(escape < 0)
+      {
+      error = "A U+{...} escape in the character set is not one to six hex digits and a }";
+      return false;
+      }
+
+    if(escape > 0)
+      {
+      if(first > last)
+        {
+        error = "A character range in the character set is reversed";
+        return false;
+        }
+      }
+    else
+      {
+      size_t len = ParseUtf8(charSet, pos, first);
+      if(len == 0)
+        {
+        error = "The character set is not valid UTF-8";
+        return false;
+        }
+
+      pos += len;
+      last = first;
+      }
+
+    if(last > FONT_MAX_CODE_POINT)
+      {
+      error = "The character set has a code point above U+10FFFF";
+      return false;
+      }
+
+    for(uint32_t ch = first; ch <= last; ch++)
+      chars.push_back(ch);
+    }
+
+  // a character given twice is only generated once
+  std::sort(chars.begin(), chars.end());
+  chars.erase(std::unique(chars.begin(), chars.end()), chars.end());
+
+  if(chars.empty())
+    {
+    error = "The character set is empty";
+    return false;
+    }
+
+  return true;
+  }
+
+#if defined(_DEBUG_FONT) && !defined(_WIN32)
+#define OutputDebugStringA(s) fputs(s, stderr)
+#endif
+
+class CharMap {
+public:
+  uint32_t start;
+  uint32_t end;
+
+  CharMap()
+    {
+    start = 0;
+    end = 0;
+    }
+  };
+
+// the glyph records of one font record once identical glyphs are shared
+struct RecordLayout
+  {
+  std::vector<const glyph_t *> records;   // the glyph records in file order
+  std::vector<uint32_t> recordChars;      // the first character of each
+  std::vector<uint32_t> recordOffsets;    // of each from the first glyph record
+  std::vector<uint32_t> charRecords;      // the glyph record of each character
+  uint32_t glyphBytes;                    // of all the glyph records, padded
+  };
+
+// ink bounding box of a glyph cell
+struct GlyphBox
+  {
+  int left;
+  int top;
+  int width;
+  int height;
+  };
+
+// load 8 coverage bytes with the leftmost pixel in the top byte
+static inline uint64_t LoadPixels(const uint8_t *p)
+  {
+  return ((uint64_t) p[0] << 56) | ((uint64_t) p[1] << 48) |
+         ((uint64_t) p[2] << 40) | ((uint64_t) p[3] << 32) |
+         ((uint64_t) p[4] << 24) | ((uint64_t) p[5] << 16) |
+         ((uint64_t) p[6] << 8) | (uint64_t) p[7];
+  }
+
+// top bit of each byte is set if the byte has any ink
+static inline uint64_t InkMask(uint64_t pixels)
+  {
+  return (((pixels & 0x7F7F7F7F7F7F7F7FULL) + 0x7F7F7F7F7F7F7F7FULL) | pixels) & 0x8080808080808080ULL;
+  }
+
+// gather the ink bits of 8 pixels into a byte, leftmost pixel is the msb
+static inline uint8_t PackPixels(uint64_t pixels)
+  {
+  return (uint8_t)((InkMask(pixels) * 0x0002040810204081ULL) >> 56);
+  }
+
+// load up to 8 pixels, pixels past the end are blank
+static inline uint64_t LoadPixels(const uint8_t *p, int count)
+  {
+  if(count >= 8)
+    return LoadPixels(p);
+
+  uint8_t tail[8] = { 0 };
+  memcpy(tail, p, count);
+  return LoadPixels(tail);
+  }
+
+// find the ink in a glyph cell in one pass over the coverage, 8 pixels
+// at a time.  Returns false if the cell is blank
+static bool FindInk(const GlyphBitmap &bm, GlyphBox &box)
+  {
+  int left = bm.width;
+  int right = -1;
+  int top = -1;
+  int bottom = -1;
+
+  for(int row = 0; row < bm.height; row++)
+    {
+    const uint8_t *line = &bm.coverage[row * bm.width];
+
+    for(int col = 0; col < bm.width; col += 8)
+      {
+      uint64_t ink = InkMask(LoadPixels(line + col, bm.width - col));
+      if(ink == 0)
+        continue;
+
+      // first and last pixel with ink in this block of 8
+      int first = col;
+      while((ink & (0x8000000000000000ULL >> ((first - col) << 3))) == 0)
+        first++;
+
+      int last = col + 7;
+      while((ink & (0x8000000000000000ULL >> ((last - col) << 3))) == 0)
+        last--;
+
+      if(first < left)
+        left = first;
+      if(last > right)
+        right = last;
+      if(top < 0)
+        top = row;
+      bottom = row;
+      }
+    }
+
+  if(top < 0)
+    return false;
+
+  box.left = left;
+  box.top = top;
+  box.width = right - left + 1;
+  box.height = bottom - top + 1;
+  return true;
+  }
+
+// pack the inked part of a cell to 1 bit per pixel rows
+static void PackGlyph(const GlyphBitmap &bm, const GlyphBox &box, uint8_t *pixels, uint16_t stride)
+  {
+  for(int row = 0; row < box.height; row++)
+    {
+    const uint8_t *line = &bm.coverage[(row + box.top) * bm.width + box.left];
+
+    for(int col = 0; col < box.width; col += 8)
+      pixels[(col >> 3) + (row * stride)] = PackPixels(LoadPixels(line + col, box.width - col));
+    }
+  }
+
+// scale antialiased coverage to the levels a depth can hold, a pixel too
+// faint for the lowest level is background
+static void QuantizeCoverage(const GlyphBitmap &bm, int bpp, GlyphBitmap &levels)
+  {
+  int maxLevel = (1 << bpp) - 1;
+
+  levels.width = bm.width;
+  levels.height = bm.height;
+  levels.coverage.resize(bm.coverage.size());
+
+  for(size_t i = 0; i < bm.coverage.size(); i++)
+    levels.coverage[i] = (uint8_t)((bm.coverage[i] * maxLevel + 127) / 255);
+  }
+
+// pack the inked part of quantized cell to rows of 2, 4 or 8 bit levels
+static void PackGlyphLevels(const GlyphBitmap &levels, const GlyphBox &box, uint8_t *pixels, uint16_t stride, int bpp)
+  {
+  int perByte = 8 / bpp;
+
+  for(int row = 0; row < box.height; row++)
+    {
+    const uint8_t *line = &levels.coverage[(row + box.top) * levels.width + box.left];
+    uint8_t *out = pixels + row * stride;
+
+    for(int col = 0; col < box.width; col++)
+      out[col / perByte] |= (uint8_t)(line[col] << (8 - bpp - (col % perByte) * bpp));
+    }
+  }
+
+FontBuilder::FontBuilder(const FontParams &params)
+: m_params(params)
+  {
+  memset(&m_report, 0, sizeof(m_report));
+  }
+
+bool FontBuilder::Fail(const char *msg)
+  {
+  m_strError = msg;
+  return false;
+  }
+
+// true if the output is C source, which holds the uncompressed FONT
+static bool IsSourceOutput(int outputType)
+  {
+  return outputType == OUTPUT_C || outputType == OUTPUT_C_STRING;
+  }
+
+const char *FontBuilder::OutputExtension(int outputType)
+  {
+  switch(outputType)
+    {
+    case OUTPUT_C:
+    case OUTPUT_C_STRING:
+      return ".c";
+    case OUTPUT_BASE64:
+      return ".txt";
+    }
+  return ".fon";
+  }
+
+bool FontBuilder::GenerateFontFile()
+  {
+  return Generate(NULL, WorkerPool::Threads(m_params.threads));
+  }
+
+bool FontBuilder::GenerateFontFile(FontRasterizer &rasterizer)
+  {
+  // a rasterizer renders one size at a time so it cannot be shared
+  return Generate(&rasterizer, 1);
+  }
+
+// bytes of the blocks glyphs are allocated from.  A 1 bit per pixel
+// glyph of 255 rows of 32 bytes fits many times, an 8 bit glyph of 255
+// rows of 255 bytes only just fits on its own
+#define GLYPH_ARENA_BLOCK 65536
+
+// largest glyph record, the glyph lengths are uint16_t
+#define MAX_GLYPH_LENGTH 65535
+
+// the glyph records of a build, carved from large zeroed blocks and freed
+// together when the build ends instead of one at a time.  A worker has its
+// own so the render threads do not share one
+class GlyphArena {
+public:
+  GlyphArena()
+    {
+    m_used = GLYPH_ARENA_BLOCK;
+    }
+
+  // zeroed space for a glyph of numBytes.  A glyph that would take most
+  // of a block gets a block of its own so the current one is kept
+  glyph_t *Alloc(size_t numBytes)
+    {
+    if(numBytes > GLYPH_ARENA_BLOCK / 2)
+      {
+      m_large.push_back(std::unique_ptr<uint8_t[]>(new uint8_t[numBytes]()));
+      return (glyph_t *) m_large.back().get();
+      }
+
+    if(numBytes > GLYPH_ARENA_BLOCK - m_used)
+      {
+      m_blocks.push_back(std::unique_ptr<uint8_t[]>(new uint8_t[GLYPH_ARENA_BLOCK]()));
+      m_used = 0;
+      }
+
+    glyph_t *pGlyph = (glyph_t *)(m_blocks.back().get() + m_used);
+    m_used += numBytes;
+    return pGlyph;
+    }
+
+private:
+  std::vector<std::unique_ptr<uint8_t[]> > m_blocks;
+  std::vector<std::unique_ptr<uint8_t[]> > m_large;     // blocks of one glyph
+  size_t m_used;              // bytes of the last block handed out
+  };
+
+// pack the ink of a cell into a new glyph record, the caller fills in
+// the advance and the placement.  The glyph is allocated rounded up to
+// the record alignment, with room for the encoding byte if it is to be
+// encoded.  Box is the ink and isSpace is set if there is none.  Returns
+// NULL and sets error if the ink does not fit a glyph record
+static glyph_t *PackCell(const GlyphBitmap &cell, int bpp, bool encoded, GlyphArena &arena, GlyphBox &box,
+  bool &isSpace, const char *&error)
+  {
+  // deeper glyphs are trimmed to the pixels that keep some coverage
+  GlyphBitmap levels;
+  if(bpp > 1)
+    QuantizeCoverage(cell, bpp, levels);
+
+  const GlyphBitmap &bm = bpp > 1 ? levels : cell;
+
+  uint16_t stride = 0;
+
+  size_t numBytes = sizeof(glyph_t) + (encoded ? 1 : 0);
+
+  // a glyph that renders nothing is stored like a space.  A packed cell
+  // was trimmed by the rasterizer
+  if(cell.packed)
+    {
+    box.left = cell.inkLeft;
+    box.top = cell.inkTop;
+    box.width = cell.inkWidth;
+    box.height = cell.inkHeight;
+    isSpace = cell.inkWidth == 0;
+    }
+  else
+    isSpace = !FindInk(bm, box);
+
+  if (!isSpace)
+    {
+    // the width and height are bytes of the record
+    if(box.width > UINT8_MAX || box.height > UINT8_MAX)
+      {
+      error = "A glyph is more than 255 pixels wide or tall, use a smaller pixel size";
+      return NULL;
+      }
+
+    stride = FontStride((uint16_t) box.width, bpp);
+
+    numBytes += stride * box.height;
+    if(numBytes > MAX_GLYPH_LENGTH)
+      {
+      error = "A glyph is more than 65535 bytes, use a smaller pixel size or fewer bits per pixel";
+      return NULL;
+      }
+    }
+
+  // roung the glyph to the nearest page, the widest alignment so the
+  // glyph can be written at any alignment
+  numBytes = FontAlign((uint32_t) numBytes);
+  glyph_t *pGlyph = arena.Alloc(numBytes);
+
+  if (!isSpace)
+    {
+    pGlyph->width = (uint8_t) box.width;
+    pGlyph->height = (uint8_t) box.height;
+
+    if(cell.packed)
+      memcpy(pGlyph->pixels, &cell.bits[0], stride * box.height);
+    else if(bpp > 1)
+      PackGlyphLevels(bm, box, pGlyph->pixels, stride, bpp);
+    else
+      PackGlyph(bm, box, pGlyph->pixels, stride);
+    }
+
+  return pGlyph;
+  }
+
+// the advance is a byte of the record
+static bool CheckAdvance(int advance, const char *&error)
+  {
+  if(advance <= UINT8_MAX)
+    return true;
+
+  error = "A glyph advances more than 255 pixels, use a smaller pixel size";
+  return false;
+  }
+
+// convert a rendered cell to a glyph record, trimmed to the ink.  NULL
+// and error if it does not fit a record
+static glyph_t *BuildGlyph(const GlyphBitmap &cell, int ascent, int bpp, bool encoded, GlyphArena &arena,
+  const char *&error)
+  {
+  if(!CheckAdvance(cell.width, error))
+    return NULL;
+
+  GlyphBox box;
+  bool isSpace;
+  glyph_t *pGlyph = PackCell(cell, bpp, encoded, arena, box, isSpace, error);
+  if(pGlyph == NULL)
+    return NULL;
+
+  pGlyph->advance = (uint8_t) cell.width;
+  pGlyph->baseline = (uint8_t) ascent;
+
+  // remove the rows at the top that are blank.
+  if (!isSpace)
+    pGlyph->baseline -= (uint8_t) box.top;
+
+  return pGlyph;
+  }
+
+// convert a rotated cell to a glyph record of a rotated set.  The ink is
+// placed from the pen with signed bytes, NULL and error if it is too far
+// away or does not fit a record
+static glyph_t *BuildRotatedGlyph(const GlyphBitmap &cell, int bpp, bool encoded, GlyphArena &arena,
+  const char *&error)
+  {
+  if(!CheckAdvance(cell.advance, error))
+    return NULL;
+
+  GlyphBox box;
+  bool isSpace;
+  glyph_t *pGlyph = PackCell(cell, bpp, encoded, arena, box, isSpace, error);
+  if(pGlyph == NULL)
+    return NULL;
+
+  pGlyph->advance = (uint8_t) cell.advance;
+
+  if (!isSpace)
+    {
+    int offset = box.left - cell.originX;
+    int baseline = cell.originY - box.top;
+    if(offset < INT8_MIN || offset > INT8_MAX || baseline < INT8_MIN || baseline > INT8_MAX)
+      {
+      error = "A rotated glyph is too far from the pen, use a smaller pixel size";
+      return NULL;
+      }
+
+    pGlyph->offset = (uint8_t)(int8_t) offset;
+    pGlyph->baseline = (uint8_t)(int8_t) baseline;
+    }
+
+  return pGlyph;
+  }
+
+// bytes of the row runs of a glyph
+static uint16_t RunsLength(const uint8_t *runs, int height)
+  {
+  const uint8_t *p = runs;
+  for(int row = 0; row < height; row++)
+    p += *p == FONT_RUNS_REPEAT ? 1 : 1 + (*p << 1);
+
+  return (uint16_t)(p - runs);
+  }
+
+// bytes of row runs worth trying, the pixels of the largest glyph and
+// then the runs of one more row
+#define MAX_GLYPH_RUNS (32 * 255 + 1 + 2 * 128)
+
+// store a 1 bit per pixel glyph as the runs of ink on each row when that
+// is smaller.  The glyph becomes the form of a record with encoded glyphs,
+// the pixels start with the encoding.  It is encoded in place so it must
+// have been packed with room for the encoding byte
+static void EncodeGlyph(glyph_t *pGlyph)
+  {
+  uint16_t stride = FontStride(pGlyph->width);
+  uint16_t rawLength = stride * pGlyph->height;
+
+  // the runs are given up once they are no smaller than the pixels
+  uint8_t runs[MAX_GLYPH_RUNS];
+  size_t numRuns = 0;
+  bool useRuns = true;
+  for(int row = 0; row < pGlyph->height && useRuns; row++)
+    {
+    const uint8_t *line = pGlyph->pixels + row * stride;
+
+    // a row the same as the one above, a stem or a bar, is one byte
+    if(row > 0 && memcmp(line, line - stride, stride) == 0)
+      runs[numRuns++] = FONT_RUNS_REPEAT;
+    else
+      {
+      size_t count = numRuns++;
+      runs[count] = 0;
+
+      int col = 0;
+      while(col < pGlyph->width)
+        {
+        if((line[col >> 3] & (0x80 >> (col & 7))) == 0)
+          {
+          col++;
+          continue;
+          }
+
+        int start = col;
+        while(col < pGlyph->width && (line[col >> 3] & (0x80 >> (col & 7))) != 0)
+          col++;
+
+        runs[numRuns++] = (uint8_t) start;
+        runs[numRuns++] = (uint8_t)(col - start);
+        runs[count]++;
+        }
+
+      if(runs[count] >= FONT_RUNS_REPEAT)
+        useRuns = false;
+      }
+
+    if(numRuns >= rawLength)
+      useRuns = false;
+    }
+
+  // a space has no pixels to be smaller than
+  useRuns = useRuns && numRuns < rawLength;
+  if(useRuns)
+    {
+    memcpy(pGlyph->pixels + 1, runs, numRuns);
+    // the rest of the pixels are padding now
+    memset(pGlyph->pixels + 1 + numRuns, 0, rawLength - numRuns);
+    }
+  else
+    memmove(pGlyph->pixels + 1, pGlyph->pixels, rawLength);
+
+  pGlyph->pixels[0] = useRuns ? FONT_GLYPH_RUNS : FONT_GLYPH_RAW;
+  }
+
+// bytes of a glyph before it is padded, encoded glyphs have the encoding
+// before the pixels
+static uint16_t GlyphLength(const glyph_t *pGlyph, int bpp, bool encoded)
+  {
+  if(encoded && pGlyph->pixels[0] == FONT_GLYPH_RUNS)
+    return (uint16_t)(sizeof(glyph_t) + 1 + RunsLength(pGlyph->pixels + 1, pGlyph->height));
+
+  uint16_t stride = FontStride(pGlyph->width, bpp);
+  return (uint16_t)(sizeof(glyph_t) + (encoded ? 1 : 0) + stride * pGlyph->height);
+  }
+
+// bytes a glyph takes in the font record
+static uint16_t GlyphSize(const glyph_t *pGlyph, int bpp, bool encoded, int alignment)
+  {
+  return (uint16_t) FontAlign(GlyphLength(pGlyph, bpp, encoded), alignment);
+  }
+
+// append a big endian value of numBytes
+static void PutBigEndian(std::vector<uint8_t> &buffer, uint32_t value, uint32_t numBytes)
+  {
+  while(numBytes-- > 0)
+    buffer.push_back((uint8_t)(value >> (numBytes << 3)));
+  }
+
+// write a big endian value of numBytes, returns the byte after it
+static uint8_t *PutBigEndian(uint8_t *p, uint32_t value, uint32_t numBytes)
+  {
+  while(numBytes-- > 0)
+    *p++ = (uint8_t)(value >> (numBytes << 3));
+
+  return p;
+  }
+
+// FNV-1a hash of a glyph record
+static uint32_t HashGlyph(const glyph_t *pGlyph, uint16_t numBytes)
+  {
+  const uint8_t *p = (const uint8_t *) pGlyph;
+  uint32_t hash = 2166136261u;
+
+  for(uint16_t i = 0; i < numBytes; i++)
+    {
+    hash ^= p[i];
+    hash *= 16777619u;
+    }
+
+  return hash;
+  }
+
+// characters rendered by one job
+#define GLYPH_BATCH 64
+
+// seconds since a time
+static double SecondsSince(std::chrono::steady_clock::time_point start)
+  {
+  return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+  }
+
+// the glyphs of one record, filled in by the render jobs
+class SizeGlyphs {
+public:
+  RasterMetrics metrics;
+  std::vector<glyph_t *> glyphs;     // in the arenas of the build
+  std::vector<uint32_t> renderChars;  // characters that have to be rendered
+  std::vector<size_t> renderSlots;    // where their glyphs go
+  int pixels;                 // pixel size
+  int angle;                  // degrees the glyphs are turned, 0 for upright
+  size_t upright;             // record of the upright glyphs of the size
+
+  SizeGlyphs()
+    {
+    memset(&metrics, 0, sizeof(metrics));
+    pixels = 0;
+    angle = 0;
+    upright = 0;
+    }
+
+private:
+  SizeGlyphs(const SizeGlyphs &);
+  SizeGlyphs &operator=(const SizeGlyphs &);
+  };
+
+// the angles of the rotated glyph sets from 0 to 359, 0 is the upright
+// record.  Empty if there are none
+static void RotationAngles(const FontParams &params, std::vector<int> &angles)
+  {
+  angles.clear();
+  if(params.stepAngle <= 0)
+    return;
+
+  for(int angle = params.startAngle; angle < params.endAngle; angle += params.stepAngle)
+    angles.push_back((angle % 360 + 360) % 360);
+  }
+
+// a run of characters of one size
+struct RenderJob
+  {
+  size_t fontNum;
+  size_t first;
+  size_t count;
+  std::string error;
+  double renderSeconds;       // spent rasterizing the batch
+  double packSeconds;         // and building its glyph records
+  };
+
+// everything a build holds from making its render jobs to assembling
+// the records
+struct GenerateState
+  {
+  std::vector<uint32_t> chars;        // the sorted code points
+  std::vector<SizeGlyphs> sizes;
+  std::vector<RenderJob> jobs;
+  std::unique_ptr<GlyphCache> cache;
+  std::vector<CachedRecord> cached;
+  FontRasterizer *rasterizer;         // NULL for a rasterizer per worker
+  std::vector<std::unique_ptr<FontRasterizer> > workerRasterizers;
+  std::vector<int> workerSize;
+  std::vector<std::vector<GlyphBitmap> > workerBitmaps;
+  std::vector<GlyphArena> workerArenas;
+  GlyphArena cacheArena;              // the glyphs loaded from the cache
+  std::atomic<bool> failed;
+
+  GenerateState(size_t numFonts)
+  : sizes(numFonts), rasterizer(NULL), failed(false)
+    {
+    }
+  };
+
+FontBuilder::~FontBuilder()
+  {
+  }
+
+size_t FontBuilder::NumBatches() const
+  {
+  return m_state ? m_state->jobs.size() : 0;
+  }
+
+bool FontBuilder::Generate(FontRasterizer *rasterizer, int threads)
+  {
+  if(!BeginGenerate(rasterizer, threads))
+    return false;
+
+  WorkerPool::Run(NumBatches(), (int) m_state->workerBitmaps.size(), [&](size_t item, int worker)
+    {
+    RenderBatch(item, worker);
+    });
+
+  return EndGenerate();
+  }
+
+bool FontBuilder::GenerateFontFiles(const std::vector<FontBuilder *> &builders, int threads)
+  {
+  threads = WorkerPool::Threads(threads);
+
+  // the batches of every font go to the one pool so a font with few
+  // glyphs does not leave threads idle while a large one renders
+  std::vector<std::pair<size_t, size_t> > batches;
+  std::vector<bool> begun(builders.size());
+  for(size_t b = 0; b < builders.size(); b++)
+    {
+    begun[b] = builders[b]->BeginGenerate(NULL, threads);
+    for(size_t n = 0; begun[b] && n < builders[b]->NumBatches(); n++)
+      batches.push_back(std::make_pair(b, n));
+    }
+
+  WorkerPool::Run(batches.size(), threads, [&](size_t item, int worker)
+    {
+    builders[batches[item].first]->RenderBatch(batches[item].second, worker);
+    });
+
+  bool generated = true;
+  for(size_t b = 0; b < builders.size(); b++)
+    generated = (begun[b] && builders[b]->EndGenerate()) && generated;
+
+  return generated;
+  }
+
+bool FontBuilder::BeginGenerate(FontRasterizer *rasterizer, int threads)
+  {
+  m_state.reset();
+  m_fontFile.clear();
+  m_strError.clear();
+  m_strWarning.clear();
+  m_recordReports.clear();
+  memset(&m_report, 0, sizeof(m_report));
+  m_report.codec = -1;
+
+  if(m_params.sizes.empty())
+    return Fail("No pixel sizes to generate");
+
+  if(!FontValidBpp(m_params.bitsPerPixel))
+    return Fail("The bits per pixel must be 1, 2, 4 or 8");
+
+  if(m_params.runLengthGlyphs && m_params.bitsPerPixel != 1)
+    return Fail("Run length glyphs need 1 bit per pixel");
+
+  if(!FontValidAlignment(m_params.alignment))
+    return Fail("The alignment must be 1, 2, 4 or 16");
+
+  if(m_params.pageSize != 0 &&
+     (m_params.pageSize < (1u << FONT_MIN_PAGE_SHIFT) || m_params.pageSize > (1u << FONT_MAX_PAGE_SHIFT) ||
+      (m_params.pageSize & (m_params.pageSize - 1)) != 0))
+    return Fail("The page size must be a power of 2 from 256 to 65536");
+
+  if(m_params.stepAngle < 0 || m_params.stepAngle >= 360)
+    return Fail("The rotation step must be from 1 to 359 degrees");
+
+  if(m_params.stepAngle > 0 &&
+     (m_params.endAngle <= m_params.startAngle || m_params.endAngle - m_params.startAngle > 360))
+    return Fail("The rotation must end after it starts and within a turn of the start");
+
+  // the upright records come first, then the turned records of each size
+  std::vector<int> angles;
+  RotationAngles(m_params, angles);
+  size_t numTurned = angles.size() - std::count(angles.begin(), angles.end(), 0);
+
+  size_t numRecords = m_params.sizes.size() * (1 + numTurned);
+  if(numRecords > 255)
+    return Fail("There are too many pixel sizes and angles, a font has at most 255 records");
+
+  uint16_t numFonts = (uint16_t) numRecords;
+  m_report.rotatedRecords = (uint32_t)(numRecords - m_params.sizes.size());
+
+  m_state.reset(new GenerateState(numFonts));
+  GenerateState &state = *m_state;
+
+  // the sorted code points
+  std::vector<uint32_t> &chars = state.chars;
+  if(!FontParams::ParseCharSet(m_params.charSet, chars, m_strError))
+    return false;
+
+  for(size_t n = 0; n < m_params.tapeSizes.size(); n++)
+    {
+    if(std::find(m_params.sizes.begin(), m_params.sizes.end(), m_params.tapeSizes[n]) == m_params.sizes.end())
+      return Fail("A digit tape size is not one of the pixel sizes");
+    }
+
+  for(uint32_t digit = '0'; !m_params.tapeSizes.empty() && digit <= '9'; digit++)
+    {
+    if(!std::binary_search(chars.begin(), chars.end(), digit))
+      return Fail("A digit tape needs the digits 0 to 9 in the character set");
+    }
+
+  // every size and every glyph is independent until the records are
+  // assembled so the characters of each size are split into batches that
+  // the workers render in any order.
+  std::vector<SizeGlyphs> &sizes = state.sizes;
+  std::vector<RenderJob> &jobs = state.jobs;
+
+  // glyphs already in the cache are not rendered again.  A face the
+  // cache cannot key by its data is always rendered
+  std::unique_ptr<GlyphCache> &cache = state.cache;
+  std::vector<CachedRecord> &cached = state.cached;
+  if(!m_params.cacheDir.empty())
+    {
+    cache.reset(new GlyphCache(m_params.cacheDir, m_params));
+    if(cache->IsValid())
+      cached.resize(numFonts);
+    else
+      cache.reset();
+    }
+
+  for(uint16_t fontNum = 0; fontNum < numFonts; fontNum++)
+    {
+    SizeGlyphs &glyphs = sizes[fontNum];
+    if(fontNum < m_params.sizes.size())
+      glyphs.upright = fontNum;
+    else
+      {
+      size_t turn = fontNum - m_params.sizes.size();
+      glyphs.upright = turn / numTurned;
+      for(size_t a = 0, n = 0; a < angles.size(); a++)
+        if(angles[a] != 0 && n++ == turn % numTurned)
+          glyphs.angle = angles[a];
+      }
+
+    glyphs.pixels = m_params.sizes[glyphs.upright];
+    glyphs.glyphs.resize(chars.size(), NULL);
+
+    CachedRecord *record = NULL;
+    if(cache && cache->Load(glyphs.pixels, glyphs.angle, cached[fontNum]))
+      {
+      record = &cached[fontNum];
+      glyphs.metrics = record->metrics;
+      }
+
+    for(size_t c = 0; c < chars.size(); c++)
+      {
+      std::map<uint32_t, std::vector<uint8_t> >::const_iterator it;
+      if(record != NULL && (it = record->glyphs.find(chars[c])) != record->glyphs.end())
+        {
+        // allocated as a built glyph is, rounded up and zero padded
+        glyph_t *pGlyph = state.cacheArena.Alloc(FontAlign((uint32_t) it->second.size()));
+        memcpy(pGlyph, &it->second[0], it->second.size());
+
+        glyphs.glyphs[c] = pGlyph;
+        m_report.cachedGlyphs++;
+        continue;
+        }
+
+      glyphs.renderChars.push_back(chars[c]);
+      glyphs.renderSlots.push_back(c);
+      }
+
+    for(size_t first = 0; first < glyphs.renderChars.size(); first += GLYPH_BATCH)
+      {
+      RenderJob job;
+      job.fontNum = fontNum;
+      job.first = first;
+      job.count = std::min((size_t) GLYPH_BATCH, glyphs.renderChars.size() - first);
+      job.renderSeconds = 0;
+      job.packSeconds = 0;
+      jobs.push_back(job);
+      }
+    }
+
+  if(rasterizer != NULL)
+    threads = 1;
+
+  // each worker renders with its own rasterizer, created when the worker
+  // runs its first job.
+  state.rasterizer = rasterizer;
+  state.workerRasterizers.resize(threads);
+  state.workerSize.assign(threads, 0);
+  state.workerBitmaps.resize(threads);
+  state.workerArenas.resize(threads);
+  return true;
+  }
+
+void FontBuilder::RenderBatch(size_t item, int worker)
+  {
+  GenerateState &state = *m_state;
+  RenderJob &job = state.jobs[item];
+
+  if(state.failed)
+    return;
+
+  FontRasterizer *r = state.rasterizer;
+  if(r == NULL)
+    {
+    if(!state.workerRasterizers[worker])
+      state.workerRasterizers[worker].reset(FontRasterizer::Create(m_params, job.error));
+
+    r = state.workerRasterizers[worker].get();
+    if(r == NULL)
+      {
+      state.failed = true;
+      return;
+      }
+    }
+
+  SizeGlyphs &glyphs = state.sizes[job.fontNum];
+  int size = glyphs.pixels;
+  if(state.workerSize[worker] != size)
+    {
+    if(!r->SelectSize(size))
+      {
+      job.error = r->Error();
+      state.workerSize[worker] = 0;
+      state.failed = true;
+      return;
+      }
+
+    state.workerSize[worker] = size;
+    }
+
+  std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+
+  std::vector<GlyphBitmap> &bitmaps = state.workerBitmaps[worker];
+  bool rendered = true;
+  if(glyphs.angle == 0)
+    rendered = r->RenderGlyphs(&glyphs.renderChars[job.first], job.count, bitmaps);
+  else
+    {
+    bitmaps.resize(job.count);
+    for(size_t n = 0; n < job.count && rendered; n++)
+      rendered = r->RenderRotated(glyphs.renderChars[job.first + n], glyphs.angle, bitmaps[n]);
+    }
+
+  if(!rendered)
+    {
+    job.error = r->Error();
+    state.failed = true;
+    return;
+    }
+
+  job.renderSeconds = SecondsSince(start);
+  start = std::chrono::steady_clock::now();
+
+  const RasterMetrics &metrics = r->Metrics();
+
+  // the first batch of a size owns the metrics
+  if(job.first == 0)
+    glyphs.metrics = metrics;
+
+  GlyphArena &arena = state.workerArenas[worker];
+
+  for(size_t n = 0; n < job.count; n++)
+    {
+    glyph_t *pGlyph;
+    const char *error = NULL;
+    if(glyphs.angle == 0)
+      pGlyph = BuildGlyph(bitmaps[n], metrics.ascent, m_params.bitsPerPixel, m_params.runLengthGlyphs, arena, error);
+    else
+      pGlyph = BuildRotatedGlyph(bitmaps[n], m_params.bitsPerPixel, m_params.runLengthGlyphs, arena, error);
+
+    if(pGlyph == NULL)
+      {
+      job.error = error;
+      state.failed = true;
+      return;
+      }
+
+    if(m_params.runLengthGlyphs)
+      EncodeGlyph(pGlyph);
+
+    glyphs.glyphs[glyphs.renderSlots[job.first + n]] = pGlyph;
+    }
+
+  job.packSeconds = SecondsSince(start);
+  }
+
+bool FontBuilder::EndGenerate()
+  {
+  // the state is released however this returns
+  std::unique_ptr<GenerateState> owner(std::move(m_state));
+  GenerateState &state = *owner;
+  std::vector<uint32_t> &chars = state.chars;
+  std::vector<SizeGlyphs> &sizes = state.sizes;
+  std::vector<RenderJob> &jobs = state.jobs;
+  std::unique_ptr<GlyphCache> &cache = state.cache;
+  std::vector<CachedRecord> &cached = state.cached;
+  uint16_t numFonts = (uint16_t) sizes.size();
+  std::vector<CharMap> charMaps;
+
+  // report the first failure in job order so the message does not depend
+  // on the thread timing
+  for(size_t n = 0; n < jobs.size(); n++)
+    if(!jobs[n].error.empty())
+      return Fail(jobs[n].error);
+
+  if(state.failed)
+    return Fail("Cannot render the glyphs");
+
+  m_recordReports.assign(numFonts, RecordReport());
+  for(size_t n = 0; n < jobs.size(); n++)
+    {
+    RecordReport &record = m_recordReports[jobs[n].fontNum];
+    record.renderSeconds += jobs[n].renderSeconds;
+    record.packSeconds += jobs[n].packSeconds;
+    m_report.renderSeconds += jobs[n].renderSeconds;
+    m_report.packSeconds += jobs[n].packSeconds;
+    }
+
+  // what each character was built as, for VerifyFontFile
+  m_glyphHashes.assign(numFonts, std::vector<uint32_t>(chars.size()));
+  for(size_t fontNum = 0; fontNum < sizes.size(); fontNum++)
+    for(size_t c = 0; c < chars.size(); c++)
+      {
+      const glyph_t *pGlyph = sizes[fontNum].glyphs[c];
+      m_glyphHashes[fontNum][c] = HashGlyph(pGlyph, GlyphLength(pGlyph, m_params.bitsPerPixel, m_params.runLengthGlyphs));
+      }
+
+  // the cache keeps the glyphs of characters other builds asked for too.
+  // The file is read again so the glyphs another build of a manifest
+  // stored since this one began are kept.  The cache only saves time, a
+  // build that cannot write it still succeeds
+  for(size_t fontNum = 0; cache && fontNum < sizes.size(); fontNum++)
+    {
+    const SizeGlyphs &glyphs = sizes[fontNum];
+    if(glyphs.renderChars.empty())
+      continue;
+
+    CachedRecord &record = cached[fontNum];
+    CachedRecord stored;
+    if(cache->Load(glyphs.pixels, glyphs.angle, stored))
+      record.glyphs.insert(stored.glyphs.begin(), stored.glyphs.end());
+
+    record.metrics = glyphs.metrics;
+    for(size_t n = 0; n < glyphs.renderChars.size(); n++)
+      {
+      const glyph_t *pGlyph = glyphs.glyphs[glyphs.renderSlots[n]];
+      const uint8_t *p = (const uint8_t *) pGlyph;
+      record.glyphs[glyphs.renderChars[n]].assign(p, p + GlyphLength(pGlyph, m_params.bitsPerPixel, m_params.runLengthGlyphs));
+      }
+
+    if(!cache->Store(glyphs.pixels, glyphs.angle, record) && m_strWarning.empty())
+      m_strWarning = "The glyph cache was not written: " + cache->Error();
+    }
+
+  std::vector<RecordLayout> layouts;
+  std::vector<uint8_t> sections;     // file sections, before the records
+
+  std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+
+  // which glyphs are shared does not depend on the format so the records
+  // are laid out once and their lengths known before anything is written
+  ShareGlyphs(chars, sizes, layouts);
+
+  int version = m_params.formatVersion == FONT_VERSION_2 ? FONT_VERSION_2 : FONT_VERSION_1;
+  BuildCharMaps(version, chars, charMaps);
+  int numSections = BuildSections(version, chars, charMaps, sizes, sections);
+  uint32_t recordsLength = RecordsLength(version, charMaps, layouts);
+
+  // a font too big for the 16 bit lengths and offsets is stored as v2
+  if(version == FONT_VERSION_1 && FONT_HEADER_SIZE + sections.size() + recordsLength > FONT_MAX_FILE_LENGTH)
+    {
+    if(m_params.formatVersion == FONT_VERSION_1)
+      return Fail("The generated font file exceeds the maximumm size.  Must be < 65535 bytes.  Remove pixel sizes or characters");
+
+    version = FONT_VERSION_2;
+    BuildCharMaps(version, chars, charMaps);
+    numSections = BuildSections(version, chars, charMaps, sizes, sections);
+    recordsLength = RecordsLength(version, charMaps, layouts);
+    }
+
+  m_report.version = version;
+
+  const char *magic = IsSourceOutput(m_params.outputType) ? FONT_MAGIC : CFNT_MAGIC;
+  m_fontFile.insert(m_fontFile.end(), magic, magic + 4);
+
+  // add the uncompressed file name.
+  size_t i;
+  for(i = 0; i < m_params.fontName.length() && i < FONT_NAME_MAX; i++)
+    {
+    m_fontFile.push_back(m_params.fontName[i]);
+    }
+
+  while(i < FONT_NAME_MAX)
+    {
+    m_fontFile.push_back(0x00);
+    i++;
+    }
+
+  uint32_t fileLength = (uint32_t)(sections.size() + recordsLength);
+  fileLength += FONT_HEADER_SIZE;
+
+  if(version == FONT_VERSION_1)
+    {
+    m_fontFile.push_back((uint8_t)(fileLength >> 8));
+    m_fontFile.push_back((uint8_t) fileLength);
+
+    m_fontFile.push_back((uint8_t) numFonts);
+
+    // reserved bytes (9), the first is the version, 0 for v1 and the
+    // sixth is the codec
+    }
+  else
+    {
+    // the 16 bit length is 0 so a v1 reader does not load the file
+    m_fontFile.push_back(0);
+    m_fontFile.push_back(0);
+
+    m_fontFile.push_back((uint8_t) numFonts);
+
+    // uint8_t version
+    m_fontFile.push_back((uint8_t) version);
+
+    // uint32_t file_length
+    PutBigEndian(m_fontFile, fileLength, 4);
+
+    // uint8_t codec, uint8_t flags, uint8_t page_shift
+    }
+
+  m_fontFile.insert(m_fontFile.end(), FONT_NUM_SECTIONS_OFFSET - m_fontFile.size(), 0);
+
+  // uint8_t num_sections
+  m_fontFile.push_back((uint8_t) numSections);
+
+  if(!IsSourceOutput(m_params.outputType))
+    {
+    // the records are compressed from a buffer of their own
+    std::vector<uint8_t> outRec(recordsLength);
+    WriteRecords(version, chars, charMaps, sizes, layouts, &outRec[0]);
+    m_report.assembleSeconds = SecondsSince(start);
+
+    start = std::chrono::steady_clock::now();
+    bool compressed = CompressFontFile(outRec, sections, version);
+    m_report.compressSeconds = SecondsSince(start);
+    return compressed;
+    }
+
+  // the records are written in place after the sections
+  size_t recordsOffset = m_fontFile.size() + sections.size();
+  m_fontFile.reserve(fileLength);
+  m_fontFile.insert(m_fontFile.end(), sections.begin(), sections.end());
+  m_fontFile.resize(recordsOffset + recordsLength);
+  WriteRecords(version, chars, charMaps, sizes, layouts, &m_fontFile[recordsOffset]);
+  m_report.assembleSeconds = SecondsSince(start);
+  return true;
+  }
+
+// bytes a char map is worth when partitioning for lookup.  A reader walks
+// the maps in order so every map is a step of the lookups past it
+#define LOOKUP_MAP_COST 64
+
+// partition the sorted characters into the char maps of least cost.  A map
+// costs its header, an offset for every character it spans, holes
+// included, and mapCost.  Maps can only start and end at the runs of
+// consecutive characters so this is a dynamic program over the gaps
+// between the runs
+static void PartitionCharMaps(const std::vector<uint32_t> &chars, uint32_t headerSize, uint32_t offsetSize,
+  uint64_t mapCost, std::vector<CharMap> &charMaps)
+  {
+  std::vector<uint32_t> runStart;
+  std::vector<uint32_t> runEnd;
+  for(size_t c = 0; c < chars.size(); c++)
+    {
+    if(c > 0 && chars[c] == chars[c - 1] + 1)
+      runEnd.back() = chars[c];
+    else
+      {
+      runStart.push_back(chars[c]);
+      runEnd.push_back(chars[c]);
+      }
+    }
+
+  // cost[j] is the least cost of the first j runs, from[j] the first run
+  // of the last map of that partition
+  size_t numRuns = runStart.size();
+  std::vector<uint64_t> cost(numRuns + 1, 0);
+  std::vector<size_t> from(numRuns + 1, 0);
+  for(size_t j = 1; j <= numRuns; j++)
+    {
+    cost[j] = UINT64_MAX;
+    for(size_t i = j; i > 0; i--)
+      {
+      uint64_t span = (uint64_t)(runEnd[j - 1] - runStart[i - 1] + 1) * offsetSize;
+
+      // a map that starts earlier only costs more, a tie keeps the longer
+      // map so there are fewer to walk
+      if(span > cost[j])
+        break;
+
+      uint64_t mapTotal = cost[i - 1] + headerSize + mapCost + span;
+      if(mapTotal <= cost[j])
+        {
+        cost[j] = mapTotal;
+        from[j] = i - 1;
+        }
+      }
+    }
+
+  charMaps.clear();
+  for(size_t j = numRuns; j > 0; j = from[j])
+    {
+    CharMap map;
+    map.start = runStart[from[j]];
+    map.end = runEnd[j - 1];
+    charMaps.push_back(map);
+    }
+
+  std::reverse(charMaps.begin(), charMaps.end());
+  }
+
+// split the characters into char maps.  The alignment padding is paid
+// once for the whole table so it does not change the partition
+void FontBuilder::BuildCharMaps(int version, const std::vector<uint32_t> &chars, std::vector<CharMap> &charMaps)
+  {
+  uint32_t headerSize = FontCharMapHeaderSize(chars.back() > FONT_MAX_NARROW_CHAR);
+  uint64_t mapCost = m_params.mapPartition == MAPS_LOOKUP ? LOOKUP_MAP_COST : 0;
+
+  PartitionCharMaps(chars, headerSize, FontOffsetSize(version), mapCost, charMaps);
+
+  // a record holds at most FONT_MAX_MAPS maps, the smallest gaps are
+  // filled with null offsets until the maps fit
+  if(charMaps.size() > FONT_MAX_MAPS)
+    {
+    // gap n is between map n and map n + 1
+    std::vector<size_t> order(charMaps.size() - 1);
+    for(size_t n = 0; n < order.size(); n++)
+      order[n] = n;
+
+    std::stable_sort(order.begin(), order.end(), [&charMaps](size_t a, size_t b)
+      {
+      return charMaps[a + 1].start - charMaps[a].end < charMaps[b + 1].start - charMaps[b].end;
+      });
+
+    std::vector<bool> fill(order.size(), false);
+    for(size_t n = 0; n < charMaps.size() - FONT_MAX_MAPS; n++)
+      fill[order[n]] = true;
+
+    std::vector<CharMap> merged(1, charMaps[0]);
+    for(size_t n = 1; n < charMaps.size(); n++)
+      {
+      if(fill[n - 1])
+        merged.back().end = charMaps[n].end;
+      else
+        merged.push_back(charMaps[n]);
+      }
+
+    charMaps.swap(merged);
+    }
+
+  uint32_t spanned = 0;
+  for(size_t n = 0; n < charMaps.size(); n++)
+    spanned += charMaps[n].end - charMaps[n].start + 1;
+
+  m_report.charMaps = (uint32_t) charMaps.size();
+  m_report.mapHoles = spanned - (uint32_t) chars.size();
+  }
+
+// build the font records of the rendered sizes.  Lengths and offsets are
+// 16 bit in v1 and 32 bit in v2
+void FontBuilder::ShareGlyphs(const std::vector<uint32_t> &chars, const std::vector<SizeGlyphs> &sizes,
+  std::vector<RecordLayout> &layouts)
+  {
+  int bpp = m_params.bitsPerPixel;
+  bool encoded = m_params.runLengthGlyphs;
+  int alignment = m_params.alignment;
+
+  m_report.glyphs = 0;
+  m_report.sharedGlyphs = 0;
+  m_report.sharedBytes = 0;
+  m_report.paddingBytes = 0;
+  m_report.runGlyphs = 0;
+
+  // the glyph records written, by hash, as an open addressed table of the
+  // record numbers plus one that each size clears and reuses
+  size_t tableSize = 1;
+  while(tableSize < chars.size() * 2)
+    tableSize <<= 1;
+
+  std::vector<uint32_t> table(m_params.shareGlyphs ? tableSize : 0);
+  std::vector<uint32_t> recordHashes;
+  recordHashes.reserve(chars.size());
+
+  layouts.resize(sizes.size());
+  for(size_t fontNum = 0; fontNum < sizes.size(); fontNum++)
+    {
+    const std::vector<glyph_t *> &glyphs = sizes[fontNum].glyphs;
+    RecordLayout &layout = layouts[fontNum];
+    RecordReport &report = m_recordReports[fontNum];
+
+    layout.records.clear();
+    layout.records.reserve(chars.size());
+    layout.recordChars.clear();
+    layout.recordChars.reserve(chars.size());
+    layout.recordOffsets.clear();
+    layout.recordOffsets.reserve(chars.size());
+    layout.charRecords.resize(chars.size());
+    layout.glyphBytes = 0;
+
+    report.pixels = sizes[fontNum].pixels;
+    report.angle = sizes[fontNum].angle;
+    report.glyphs = (uint32_t) chars.size();
+    report.sharedGlyphs = 0;
+    report.bitmapBytes = 0;
+    report.paddingBytes = 0;
+    report.numLargest = 0;
+
+    std::fill(table.begin(), table.end(), 0);
+    recordHashes.clear();
+
+    for(size_t c = 0; c < chars.size(); c++)
+      {
+      const glyph_t *pGlyph = glyphs[c];
+      uint16_t glyphSize = GlyphSize(pGlyph, bpp, encoded, alignment);
+
+      m_report.glyphs++;
+
+      if(m_params.shareGlyphs)
+        {
+        uint32_t hash = HashGlyph(pGlyph, glyphSize);
+
+        // a glyph identical to one already written shares it
+        size_t slot = hash & (tableSize - 1);
+        for(; table[slot] != 0; slot = (slot + 1) & (tableSize - 1))
+          {
+          uint32_t match = table[slot] - 1;
+          const glyph_t *pRecord = layout.records[match];
+          if(recordHashes[match] == hash && GlyphSize(pRecord, bpp, encoded, alignment) == glyphSize &&
+             memcmp(pRecord, pGlyph, glyphSize) == 0)
+            break;
+          }
+
+        if(table[slot] != 0)
+          {
+          // point the character at the existing record
+          layout.charRecords[c] = table[slot] - 1;
+          m_report.sharedGlyphs++;
+          m_report.sharedBytes += glyphSize;
+          report.sharedGlyphs++;
+          continue;
+          }
+
+        table[slot] = (uint32_t) layout.records.size() + 1;
+        recordHashes.push_back(hash);
+        }
+
+      layout.charRecords[c] = (uint32_t) layout.records.size();
+      layout.records.push_back(pGlyph);
+      layout.recordChars.push_back(chars[c]);
+      layout.recordOffsets.push_back(layout.glyphBytes);
+      layout.glyphBytes += glyphSize;
+
+      uint16_t recLen = GlyphLength(pGlyph, bpp, encoded);
+      if(encoded && pGlyph->pixels[0] == FONT_GLYPH_RUNS)
+        m_report.runGlyphs++;
+
+      m_report.paddingBytes += glyphSize - recLen;
+      report.paddingBytes += glyphSize - recLen;
+      report.bitmapBytes += recLen - FONT_GLYPH_HEADER_SIZE;
+
+      // keep the largest glyphs, largest first and the earlier character
+      // of two the same size
+      uint32_t largest = report.numLargest;
+      while(largest > 0 && report.largestBytes[largest - 1] < recLen)
+        {
+        if(largest < REPORT_LARGEST_GLYPHS)
+          {
+          report.largestChars[largest] = report.largestChars[largest - 1];
+          report.largestBytes[largest] = report.largestBytes[largest - 1];
+          }
+        largest--;
+        }
+
+      if(largest < REPORT_LARGEST_GLYPHS)
+        {
+        report.largestChars[largest] = chars[c];
+        report.largestBytes[largest] = recLen;
+        if(report.numLargest < REPORT_LARGEST_GLYPHS)
+          report.numLargest++;
+        }
+      }
+    }
+  }
+
+// offset of the first glyph record in each record, after the record
+// header and the char maps and aligned
+static uint32_t FirstGlyphOffset(int version, const std::vector<CharMap> &charMaps, int alignment)
+  {
+  uint32_t offsetSize = FontOffsetSize(version);
+  uint32_t mapHeaderSize = FontCharMapHeaderSize(charMaps.back().end > FONT_MAX_NARROW_CHAR);
+
+  uint32_t offset = FontRecordHeaderSize(version);
+  for(size_t n = 0; n < charMaps.size(); n++)
+    offset += mapHeaderSize + (charMaps[n].end - charMaps[n].start + 1) * offsetSize;
+
+  return FontAlign(offset, alignment);
+  }
+
+uint32_t FontBuilder::RecordsLength(int version, const std::vector<CharMap> &charMaps,
+  const std::vector<RecordLayout> &layouts) const
+  {
+  uint32_t glyphOffset = FirstGlyphOffset(version, charMaps, m_params.alignment);
+
+  uint32_t length = 0;
+  for(size_t n = 0; n < layouts.size(); n++)
+    length += glyphOffset + layouts[n].glyphBytes;
+
+  return length;
+  }
+
+void FontBuilder::WriteRecords(int version, const std::vector<uint32_t> &chars, const std::vector<CharMap> &charMaps,
+  const std::vector<SizeGlyphs> &sizes, const std::vector<RecordLayout> &layouts, uint8_t *out)
+  {
+  uint32_t offsetSize = FontOffsetSize(version);
+  bool wideMaps = charMaps.back().end > FONT_MAX_NARROW_CHAR;
+  bool encoded = m_params.runLengthGlyphs;
+
+  // the glyphs follow the record header and the char maps
+  uint32_t glyphOffset = FirstGlyphOffset(version, charMaps, m_params.alignment);
+
+  // write the records in size order
+  uint8_t *p = out;
+  for(size_t fontNum = 0; fontNum < sizes.size(); fontNum++)
+    {
+    const RasterMetrics &metrics = sizes[fontNum].metrics;
+    const RecordLayout &layout = layouts[fontNum];
+    RecordReport &report = m_recordReports[fontNum];
+    uint8_t *record = p;
+    uint32_t len = glyphOffset + layout.glyphBytes;
+
+    // uint16_t record_size;            // length of this font record.
+    p = PutBigEndian(p, len, offsetSize);
+    // uint8_t size;                   // height of the font this bitmap renders
+    *p++ = (uint8_t) sizes[fontNum].pixels;
+    // uint8_t vertical_height;        // height including ascender/descender
+    *p++ = (uint8_t) metrics.height;
+    // uint8_t baseline;               // we assume the baseline is same as the height - could be wrong
+    *p++ = (uint8_t) metrics.ascent;
+    // uint8_t num_maps                // number of character maps
+    *p++ = (uint8_t) charMaps.size();
+    // uint8_t bits_per_pixel          // 0 is the original 1 bit per pixel
+    *p++ = (uint8_t)(m_params.bitsPerPixel > 1 ? m_params.bitsPerPixel : 0);
+    // uint8_t flags
+    *p++ = (uint8_t)((wideMaps ? FONT_RECORD_FLAG_WIDE_MAPS : 0) | (encoded ? FONT_RECORD_FLAG_ENCODED_GLYPHS : 0) |
+      (sizes[fontNum].angle != 0 ? FONT_RECORD_FLAG_ROTATED : 0));
+
+    // the char maps, a character in a map that the font does not have is
+    // a null offset
+    size_t glyph = 0;
+    for(size_t n = 0; n < charMaps.size(); n++)
+      {
+      const CharMap &map = charMaps[n];
+
+      // uint8_t start_char              // first character in the character map, uint32_t if wide
+      p = PutBigEndian(p, map.start, wideMaps ? 4 : 1);
+      // uint8_t last_char               // last character in the character map, uint32_t if wide
+      p = PutBigEndian(p, map.end, wideMaps ? 4 : 1);
+
+      // uint16_t glyphs_offset           // offset to the glyph records (offset from start of the block)
+      for(uint32_t ch = map.start; ch <= map.end; ch++)
+        {
+        if(glyph < chars.size() && chars[glyph] == ch)
+          p = PutBigEndian(p, glyphOffset + layout.recordOffsets[layout.charRecords[glyph++]], offsetSize);
+        else
+          p = PutBigEndian(p, 0, offsetSize);
+        }
+      }
+
+    report.mapBytes = (uint32_t)(p - record) - FontRecordHeaderSize(version);
+
+    // adjust to the alignment
+    uint32_t pad = glyphOffset - (uint32_t)(p - record);
+    memset(p, 0, pad);
+    p += pad;
+    m_report.paddingBytes += pad;
+    report.paddingBytes += pad;
+
+    // dump the glyphs, each is zero padded to the widest alignment when
+    // it is built so it is copied with its padding
+    for(size_t n = 0; n < layout.records.size(); n++)
+      {
+      const glyph_t *pGlyph = layout.records[n];
+      uint16_t glyphSize = GlyphSize(pGlyph, m_params.bitsPerPixel, encoded, m_params.alignment);
+
+      // uint8_t glyph_advance           // horizontal advance for the glyph
+      // uint8_t glyph_baseline          // baseline of the bitmap, is aligned to the baseline when rendered
+      // uint8_t offset                  // offset to column 0
+      // uint8_t width                   // width of the actual glyph
+      // uint8_t height                  // height of the glyph
+      // uint8_t encoding                // FONT_GLYPH_ of a record with encoded glyphs
+      // uint8_t bitmap[stride * height]  // alpha values of the bitmap, or the row runs
+      memcpy(p, pGlyph, glyphSize);
+      p += glyphSize;
+
+#ifdef _DEBUG_FONT
+      {
+      static char buf[256];
+      uint16_t stride = FontStride(pGlyph->width, m_params.bitsPerPixel);
+      snprintf(buf, 256, "Character 0x%04.4x\r\n", layout.recordChars[n]);
+      OutputDebugStringA(buf);
+      snprintf(buf, 256, "Offset : %u\r\n", glyphOffset + layout.recordOffsets[n]);
+      OutputDebugStringA(buf);
+      snprintf(buf, 256, "-------------------\r\n");
+      OutputDebugStringA(buf);
+      for(int row = 0; row < pGlyph->height; row++)
+        {
+        for(int col = 0; col < stride; col++)
+          {
+          snprintf(buf, 256, "0x%02.2x ", pGlyph->pixels[col + (row * stride)]);
+          OutputDebugStringA(buf);
+          }
+        snprintf(buf, 256, "\r\n");
+        OutputDebugStringA(buf);
+        }
+      snprintf(buf, 256, "-------------------\r\n");
+      OutputDebugStringA(buf);
+      }
+#endif
+      }
+
+    report.recordBytes = len;
+    report.headerBytes = FontRecordHeaderSize(version) + (uint32_t) layout.records.size() * FONT_GLYPH_HEADER_SIZE;
+    report.compressedBytes = 0;
+    }
+
+  m_report.recordBytes = (uint32_t)(p - out);
+  }
+
+// append a section, the data is padded to 4 bytes
+static void PutSection(std::vector<uint8_t> &sections, const char *tag, const std::vector<uint8_t> &data)
+  {
+  sections.insert(sections.end(), tag, tag + 4);
+  PutBigEndian(sections, (uint32_t) data.size(), 4);
+  sections.insert(sections.end(), data.begin(), data.end());
+  sections.insert(sections.end(), FontAlign((uint32_t) data.size(), 4) - data.size(), 0);
+  }
+
+// the char maps are the same in every record so one table gives the
+// position of a character's glyph offset in all of them
+void FontBuilder::BuildAccelTable(int version, const std::vector<CharMap> &charMaps, std::vector<uint8_t> &accel)
+  {
+  uint32_t offsetSize = FontOffsetSize(version);
+  uint32_t mapHeaderSize = FontCharMapHeaderSize(charMaps.back().end > FONT_MAX_NARROW_CHAR);
+  uint32_t numIndex = (charMaps.back().end >> 8) + 1;
+
+  // only the pages of 256 characters that have a character are stored
+  std::vector<uint32_t> pageOf(numIndex, FONT_ACCEL_NO_PAGE);
+  uint32_t numPages = 0;
+  for(size_t n = 0; n < charMaps.size(); n++)
+    for(uint32_t ch = charMaps[n].start; ch <= charMaps[n].end; ch++)
+      if(pageOf[ch >> 8] == FONT_ACCEL_NO_PAGE)
+        pageOf[ch >> 8] = numPages++;
+
+  std::vector<uint32_t> entries(numPages << 8, 0);
+  uint32_t pos = FontRecordHeaderSize(version);
+  for(size_t n = 0; n < charMaps.size(); n++)
+    {
+    pos += mapHeaderSize;
+    for(uint32_t ch = charMaps[n].start; ch <= charMaps[n].end; ch++, pos += offsetSize)
+      entries[(pageOf[ch >> 8] << 8) | (ch & 0xFF)] = pos;
+    }
+
+  accel.clear();
+
+  // uint32_t num_index
+  PutBigEndian(accel, numIndex, 4);
+  // uint16_t page_index[num_index]
+  for(uint32_t i = 0; i < numIndex; i++)
+    PutBigEndian(accel, pageOf[i], 2);
+  // uint16_t entries[num_pages][256], uint32_t in v2
+  for(size_t i = 0; i < entries.size(); i++)
+    PutBigEndian(accel, entries[i], offsetSize);
+  }
+
+// build the file sections, returns the number of sections
+// compose the digits of the tape sizes into strips, laid out the way the
+// glyphs are drawn in a line of text and centered on the widest digit
+void FontBuilder::BuildDigitTapes(const std::vector<uint32_t> &chars, const std::vector<SizeGlyphs> &sizes,
+  std::vector<uint8_t> &tapes)
+  {
+  int bpp = m_params.bitsPerPixel;
+  size_t numTapes = m_params.tapeSizes.size();
+
+  tapes.clear();
+  // uint8_t num_tapes, reserved[3]
+  tapes.push_back((uint8_t) numTapes);
+  tapes.insert(tapes.end(), 3, 0);
+
+  std::vector<uint8_t> bitmaps;
+  for(size_t n = 0; n < numTapes; n++)
+    {
+    size_t fontNum = std::find(m_params.sizes.begin(), m_params.sizes.end(), m_params.tapeSizes[n]) - m_params.sizes.begin();
+    const SizeGlyphs &size = sizes[fontNum];
+
+    FontGlyphView digits[10];
+    int width = 0;
+    for(int d = 0; d < 10; d++)
+      {
+      size_t glyph = std::lower_bound(chars.begin(), chars.end(), (uint32_t)('0' + d)) - chars.begin();
+      digits[d] = FontGlyphView(size.glyphs[glyph], bpp, m_params.runLengthGlyphs);
+      width = std::max(width, std::max((int) digits[d].Advance(), digits[d].Offset() + digits[d].Width()));
+      }
+
+    int digitHeight = size.metrics.height;
+    uint16_t stride = FontStride((uint16_t) width, bpp);
+    size_t bitmapStart = bitmaps.size();
+    bitmaps.resize(bitmapStart + stride * digitHeight * FONT_TAPE_DIGITS, 0);
+
+    for(int cell = 0; cell < FONT_TAPE_DIGITS; cell++)
+      {
+      const FontGlyphView &digit = digits[cell % 10];
+      int extent = std::max((int) digit.Advance(), digit.Offset() + digit.Width());
+      int left = (width - extent) / 2 + digit.Offset();
+      int top = cell * digitHeight + size.metrics.ascent - digit.Baseline();
+
+      for(int row = 0; row < digit.Height(); row++)
+        {
+        if(top + row < cell * digitHeight || top + row >= (cell + 1) * digitHeight)
+          continue;
+
+        uint8_t *line = &bitmaps[bitmapStart + (top + row) * stride];
+        for(int col = 0; col < digit.Width(); col++)
+          {
+          int bit = (left + col) * bpp;
+          line[bit >> 3] |= (uint8_t)(digit.Pixel(col, row) << (8 - bpp - (bit & 7)));
+          }
+        }
+      }
+
+    // uint8_t size, bits_per_pixel, width, digit_height, baseline, reserved[3]
+    tapes.push_back((uint8_t) m_params.tapeSizes[n]);
+    tapes.push_back((uint8_t)(bpp > 1 ? bpp : 0));
+    tapes.push_back((uint8_t) width);
+    tapes.push_back((uint8_t) digitHeight);
+    tapes.push_back((uint8_t) size.metrics.ascent);
+    tapes.insert(tapes.end(), 3, 0);
+    // uint32_t offset
+    PutBigEndian(tapes, (uint32_t)(FONT_TAPE_HEADER_SIZE + numTapes * FONT_TAPE_ENTRY_SIZE + bitmapStart), 4);
+    }
+
+  tapes.insert(tapes.end(), bitmaps.begin(), bitmaps.end());
+  }
+
+// the metrics of every glyph as arrays in char map order, one set for
+// each record
+void FontBuilder::BuildMetricsTable(const std::vector<uint32_t> &chars, const std::vector<CharMap> &charMaps,
+  const std::vector<SizeGlyphs> &sizes, std::vector<uint8_t> &metrics)
+  {
+  uint32_t numSlots = 0;
+  for(size_t n = 0; n < charMaps.size(); n++)
+    numSlots += charMaps[n].end - charMaps[n].start + 1;
+
+  uint32_t boxStart = FontAlign(numSlots, 4);
+  uint32_t arraysLength = boxStart + numSlots * FONT_METRICS_BOX_SIZE;
+  uint32_t offset = (uint32_t)(FONT_METRICS_HEADER_SIZE + sizes.size() * FONT_METRICS_ENTRY_SIZE);
+
+  metrics.clear();
+  // uint8_t num_metrics, reserved[3]
+  metrics.push_back((uint8_t) sizes.size());
+  metrics.insert(metrics.end(), 3, 0);
+  // uint32_t num_slots
+  PutBigEndian(metrics, numSlots, 4);
+
+  for(size_t fontNum = 0; fontNum < sizes.size(); fontNum++)
+    {
+    // uint8_t size, reserved[3]
+    metrics.push_back((uint8_t) sizes[fontNum].pixels);
+    metrics.insert(metrics.end(), 3, 0);
+    // uint32_t offset
+    PutBigEndian(metrics, offset + (uint32_t) fontNum * arraysLength, 4);
+    }
+
+  for(size_t fontNum = 0; fontNum < sizes.size(); fontNum++)
+    {
+    const std::vector<glyph_t *> &glyphs = sizes[fontNum].glyphs;
+    size_t start = metrics.size();
+    metrics.resize(start + arraysLength, 0);
+
+    uint8_t *advance = &metrics[start];
+    uint8_t *box = advance + boxStart;
+    size_t glyph = 0;
+    for(size_t n = 0; n < charMaps.size(); n++)
+      {
+      for(uint32_t ch = charMaps[n].start; ch <= charMaps[n].end; ch++, advance++, box += FONT_METRICS_BOX_SIZE)
+        {
+        if(chars[glyph] != ch)
+          continue;
+
+        const glyph_t *pGlyph = glyphs[glyph++];
+        *advance = pGlyph->advance;
+        box[0] = pGlyph->baseline;
+        box[1] = pGlyph->offset;
+        box[2] = pGlyph->width;
+        box[3] = pGlyph->height;
+        }
+      }
+    }
+  }
+
+// the record of each size at each angle
+void FontBuilder::BuildRotationTable(const std::vector<SizeGlyphs> &sizes, std::vector<uint8_t> &rotation)
+  {
+  std::vector<int> angles;
+  RotationAngles(m_params, angles);
+
+  rotation.clear();
+
+  // uint16_t start_angle, step_angle
+  PutBigEndian(rotation, (uint32_t) angles[0], 2);
+  PutBigEndian(rotation, (uint32_t) m_params.stepAngle, 2);
+  // uint8_t num_angles, num_sizes, reserved[2]
+  rotation.push_back((uint8_t) angles.size());
+  rotation.push_back((uint8_t) m_params.sizes.size());
+  rotation.insert(rotation.end(), 2, 0);
+
+  for(size_t n = 0; n < m_params.sizes.size(); n++)
+    {
+    // uint8_t size, records[num_angles]
+    rotation.push_back((uint8_t) m_params.sizes[n]);
+    for(size_t a = 0; a < angles.size(); a++)
+      {
+      size_t fontNum = n;
+      for(size_t r = m_params.sizes.size(); angles[a] != 0 && r < sizes.size(); r++)
+        if(sizes[r].upright == n && sizes[r].angle == angles[a])
+          fontNum = r;
+
+      rotation.push_back((uint8_t) fontNum);
+      }
+    }
+  }
+
+int FontBuilder::BuildSections(int version, const std::vector<uint32_t> &chars, const std::vector<CharMap> &charMaps,
+  const std::vector<SizeGlyphs> &sizes, std::vector<uint8_t> &sections)
+  {
+  int numSections = 0;
+  std::vector<uint8_t> data;
+
+  sections.clear();
+
+  if(m_params.accelTable)
+    {
+    BuildAccelTable(version, charMaps, data);
+    PutSection(sections, FONT_ACCEL_TAG, data);
+    numSections++;
+    }
+
+  if(m_params.metricsTable)
+    {
+    BuildMetricsTable(chars, charMaps, sizes, data);
+    PutSection(sections, FONT_METRICS_TAG, data);
+    numSections++;
+    }
+
+  if(!m_params.tapeSizes.empty())
+    {
+    BuildDigitTapes(chars, sizes, data);
+    PutSection(sections, FONT_TAPE_TAG, data);
+    numSections++;
+    }
+
+  if(m_params.stepAngle > 0)
+    {
+    BuildRotationTable(sizes, data);
+    PutSection(sections, FONT_ROTATION_TAG, data);
+    numSections++;
+    }
+
+  m_report.sectionBytes = (uint32_t) sections.size();
+  return numSections;
+  }
+
+// the fastest codec can be this fraction larger than the smallest
+#define FASTEST_CODEC_SLACK 8
+
+// number of pages a block is split into
+static uint32_t NumPages(size_t len, uint32_t pageSize)
+  {
+  if(pageSize == 0 || len <= pageSize)
+    return 1;
+
+  return (uint32_t)((len + pageSize - 1) / pageSize);
+  }
+
+// compress a block with a codec and check that it decompresses to the
+// same bytes.  A block of more than one page starts with the compressed
+// length of each page
+bool FontBuilder::CompressPages(int codec, const uint8_t *src, size_t srcLen, std::vector<uint8_t> &compressed)
+  {
+  uint32_t numPages = NumPages(srcLen, m_params.pageSize);
+  size_t pageSize = numPages > 1 ? m_params.pageSize : srcLen;
+
+  std::string error;
+  std::vector<uint8_t> pageTable;
+  std::vector<uint8_t> pages;
+  std::vector<uint8_t> page;
+  std::vector<uint8_t> check(pageSize);
+
+  for(uint32_t n = 0; n < numPages; n++)
+    {
+    const uint8_t *pageSrc = src + n * pageSize;
+    size_t pageLen = std::min(pageSize, srcLen - n * pageSize);
+
+    if(!FontCompress(codec, pageSrc, pageLen, page, error))
+      return Fail(error);
+
+    if(!FontDecompress(codec, page.empty() ? NULL : &page[0], page.size(), &check[0], pageLen) ||
+       memcmp(&check[0], pageSrc, pageLen) != 0)
+      return Fail(std::string("The ") + FontCodecName(codec) + " codec does not decompress the font");
+
+    if(numPages > 1)
+      PutBigEndian(pageTable, (uint32_t) page.size(), 4);
+
+    pages.insert(pages.end(), page.begin(), page.end());
+    }
+
+  compressed.swap(pageTable);
+  compressed.insert(compressed.end(), pages.begin(), pages.end());
+  return true;
+  }
+
+// compress a block with the codec the params ask for.  The smallest and
+// fastest choices compress the block with every codec and return the one
+// chosen in codec
+bool FontBuilder::CompressBlock(const uint8_t *src, size_t srcLen, int &codec, std::vector<uint8_t> &compressed)
+  {
+  codec = m_params.codec;
+
+  if(codec == CODEC_DEFAULT)
+#if defined(_WIN32)
+    codec = FONT_CODEC_XPRESS_HUFF;
+#else
+    codec = FONT_CODEC_LZ4;
+#endif
+
+  if(codec != CODEC_SMALLEST && codec != CODEC_FASTEST)
+    return CompressPages(codec, src, srcLen, compressed);
+
+  // compress with every codec in this build
+  std::vector<std::vector<uint8_t> > results(FONT_NUM_CODECS);
+  size_t smallest = 0;
+
+  for(int c = 0; c < FONT_NUM_CODECS; c++)
+    {
+    if(!FontCodecAvailable(c))
+      continue;
+
+    if(!CompressPages(c, src, srcLen, results[c]))
+      return false;
+
+    if(smallest == 0 || results[c].size() < smallest)
+      smallest = results[c].size();
+    }
+
+  // the smallest wins, or the fastest to decode of those close to it.
+  // Ties go to the faster or smaller one
+  size_t limit = smallest;
+  if(m_params.codec == CODEC_FASTEST)
+    limit += smallest / FASTEST_CODEC_SLACK;
+
+  codec = -1;
+  for(int c = 0; c < FONT_NUM_CODECS; c++)
+    {
+    if(!FontCodecAvailable(c) || results[c].size() > limit)
+      continue;
+
+    if(codec < 0)
+      codec = c;
+    else if(m_params.codec == CODEC_SMALLEST ?
+      (results[c].size() < results[codec].size() ||
+       (results[c].size() == results[codec].size() && FontCodecDecodeCost(c) < FontCodecDecodeCost(codec))) :
+      (FontCodecDecodeCost(c) < FontCodecDecodeCost(codec) ||
+       (FontCodecDecodeCost(c) == FontCodecDecodeCost(codec) && results[c].size() < results[codec].size())))
+      codec = c;
+    }
+
+  compressed.swap(results[codec]);
+  return true;
+  }
+
+bool FontBuilder::CompressFontFile(const std::vector<uint8_t> &outRec, const std::vector<uint8_t> &sections, int version)
+  {
+  std::vector<uint8_t> compressed;
+  int codec;
+
+  if(!m_params.recordDirectory && m_params.pageSize == 0)
+    {
+    if(!CompressBlock(&outRec[0], outRec.size(), codec, compressed))
+      {
+      m_fontFile.clear();
+      return false;
+      }
+
+    m_fontFile[FONT_CODEC_OFFSET] = (uint8_t) codec;
+
+    // the sections are not compressed so they can be used in place
+    m_fontFile.insert(m_fontFile.end(), sections.begin(), sections.end());
+
+    // append the compressed record.
+    m_fontFile.insert(m_fontFile.end(), compressed.begin(), compressed.end());
+
+    m_report.codec = codec;
+    m_report.compressedBytes = (uint32_t) compressed.size();
+    m_report.pages = 1;
+    return true;
+    }
+
+  // each record is compressed on its own so a reader can find and
+  // decompress only the sizes it needs
+  size_t numFonts = m_fontFile[FONT_NUM_FONTS_OFFSET];
+  uint32_t offsetSize = FontOffsetSize(version);
+
+  std::vector<uint8_t> directory;
+  std::vector<uint8_t> records;
+  uint32_t dataOffset = (uint32_t)(FONT_HEADER_SIZE + numFonts * FONT_DIRECTORY_ENTRY_SIZE + sections.size());
+  int fileCodec = -1;
+  size_t pos = 0;
+
+  for(size_t fontNum = 0; fontNum < numFonts; fontNum++)
+    {
+    uint32_t recordSize = FontGetBigEndian(&outRec[pos], offsetSize);
+    const uint8_t *record = &outRec[pos];
+
+    if(!CompressBlock(record, recordSize, codec, compressed))
+      {
+      m_fontFile.clear();
+      return false;
+      }
+
+    uint32_t numPages = NumPages(recordSize, m_params.pageSize);
+
+    // uint8_t size
+    directory.push_back(record[offsetSize + FONT_RECORD_PIXEL_SIZE]);
+    // uint8_t codec
+    directory.push_back((uint8_t) codec);
+    // uint16_t num_pages
+    PutBigEndian(directory, numPages, 2);
+    // uint32_t offset
+    PutBigEndian(directory, dataOffset + (uint32_t) records.size(), 4);
+    // uint32_t compressed_length
+    PutBigEndian(directory, (uint32_t) compressed.size(), 4);
+    // uint32_t raw_length
+    PutBigEndian(directory, recordSize, 4);
+
+    records.insert(records.end(), compressed.begin(), compressed.end());
+    m_recordReports[fontNum].compressedBytes = (uint32_t) compressed.size();
+
+    fileCodec = fileCodec < 0 || fileCodec == codec ? codec : FONT_CODEC_PER_RECORD;
+    m_report.pages += numPages;
+    pos += recordSize;
+    }
+
+  uint8_t pageShift = 0;
+  while(m_params.pageSize != 0 && (1u << pageShift) < m_params.pageSize)
+    pageShift++;
+
+  m_fontFile[FONT_CODEC_OFFSET] = (uint8_t) fileCodec;
+  m_fontFile[FONT_FLAGS_OFFSET] = FONT_FLAG_DIRECTORY;
+  m_fontFile[FONT_PAGE_SHIFT_OFFSET] = pageShift;
+
+  m_fontFile.insert(m_fontFile.end(), directory.begin(), directory.end());
+  m_fontFile.insert(m_fontFile.end(), sections.begin(), sections.end());
+  m_fontFile.insert(m_fontFile.end(), records.begin(), records.end());
+
+  m_report.codec = fileCodec;
+  m_report.compressedBytes = (uint32_t)(directory.size() + records.size());
+  return true;
+  }
+
+// bytes collected before they are written to an output file
+#define OUTPUT_BLOCK_SIZE 65536
+
+// buffered writer of an output file.  The text is formatted straight into
+// a large block that is written when it fills, a write error is kept
+// until Close
+class OutputSink {
+public:
+  OutputSink()
+  : m_file(NULL), m_used(0), m_failed(false)
+    {
+    }
+
+  ~OutputSink()
+    {
+    Close();
+    }
+
+  bool Open(const std::string &fileName, bool binary)
+    {
+    m_file = fopen(fileName.c_str(), binary ? "wb" : "w");
+    m_buffer.resize(OUTPUT_BLOCK_SIZE);
+    return m_file != NULL;
+    }
+
+  void Write(const void *data, size_t len)
+    {
+    if(len > OUTPUT_BLOCK_SIZE - m_used)
+      {
+      Flush();
+
+      // a large block goes straight to the file
+      if(len >= OUTPUT_BLOCK_SIZE)
+        {
+        m_failed = m_failed || fwrite(data, 1, len, m_file) != len;
+        return;
+        }
+      }
+
+    memcpy(&m_buffer[m_used], data, len);
+    m_used += len;
+    }
+
+  void Write(const char *str)
+    {
+    Write(str, strlen(str));
+    }
+
+  // space to format up to len bytes in, at most OUTPUT_BLOCK_SIZE, then
+  // Commit the bytes used
+  char *Reserve(size_t len)
+    {
+    if(len > OUTPUT_BLOCK_SIZE - m_used)
+      Flush();
+
+    return &m_buffer[m_used];
+    }
+
+  void Commit(size_t len)
+    {
+    m_used += len;
+    }
+
+  // false if anything could not be written
+  bool Close()
+    {
+    if(m_file == NULL)
+      return !m_failed;
+
+    Flush();
+    m_failed = fclose(m_file) != 0 || m_failed;
+    m_file = NULL;
+    return !m_failed;
+    }
+
+private:
+  void Flush()
+    {
+    if(m_used > 0)
+      m_failed = m_failed || fwrite(&m_buffer[0], 1, m_used, m_file) != m_used;
+
+    m_used = 0;
+    }
+
+  FILE *m_file;
+  std::vector<char> m_buffer;
+  size_t m_used;
+  bool m_failed;
+  };
+
+static const char hexDigits[] = "0123456789abcdef";
+
+// the comment at the top of a C output
+static void WriteCHeader(OutputSink &sink, const FontParams &params)
+  {
+  char buf[32];
+
+  sink.Write("#include <stdint.h>\n");
+  sink.Write("/* autogenerated file.  Do not edit\n");
+  sink.Write("Font name: ");
+  sink.Write(params.fontName.c_str());
+  sink.Write("\nCharacter set : ");
+  sink.Write(params.charSet.c_str());
+  sink.Write("\nPixel sizes : ");
+
+  for (size_t i = 0; i < params.sizes.size(); i++)
+    {
+    snprintf(buf, sizeof(buf), "%d ", params.sizes[i]);
+    sink.Write(buf);
+    }
+
+  sink.Write("\n*/\n\n");
+  }
+
+// the length of a C output, 32 bits for a v2 font too long for 16
+static void WriteCLength(OutputSink &sink, const FontParams &params, size_t length)
+  {
+  char buf[32];
+
+  sink.Write(length > 0xffff ? "const uint32_t " : "const uint16_t ");
+  sink.Write(params.fontName.c_str());
+  snprintf(buf, sizeof(buf), "_length = %d;\n", (int) length);
+  sink.Write(buf);
+  }
+
+bool FontBuilder::WriteCOutputFile(const std::string &dataName)
+  {
+  OutputSink data;
+  if(!data.Open(dataName, false))
+    return Fail("Cannot create the output file");
+
+  WriteCHeader(data, m_params);
+  data.Write("const uint8_t ");
+  data.Write(m_params.fontName.c_str());
+  data.Write("[] = {\n");
+
+  // a line of 16 bytes, each as 0xXX,
+  for(size_t bo = 0; bo < m_fontFile.size(); bo += 16)
+    {
+    size_t count = std::min((size_t) 16, m_fontFile.size() - bo);
+    char *line = data.Reserve(1 + 16 * 6);
+    char *p = line;
+
+    *p++ = '\n';
+    for(size_t i = 0; i < count; i++)
+      {
+      uint8_t b = m_fontFile[bo + i];
+      p[0] = '0';
+      p[1] = 'x';
+      p[2] = hexDigits[b >> 4];
+      p[3] = hexDigits[b & 0x0f];
+      p[4] = ',';
+      p[5] = ' ';
+      p += 6;
+      }
+
+    data.Commit(p - line);
+    }
+
+  data.Write("};\n");
+  WriteCLength(data, m_params, m_fontFile.size());
+
+  if(!data.Close())
+    return Fail("Cannot write the output file");
+
+  return true;
+  }
+
+// characters of the string literal on each line of a C string output
+#define C_STRING_LINE_LENGTH 76
+
+bool FontBuilder::WriteCStringOutputFile(const std::string &dataName)
+  {
+  OutputSink data;
+  if(!data.Open(dataName, false))
+    return Fail("Cannot create the output file");
+
+  // the array is sized so a C compiler leaves out the terminating null.
+  // Printable bytes are themselves so the file is a fraction of the size
+  // of a C array, the rest are the shortest octal escape that the next
+  // byte cannot extend
+  char buf[32];
+  WriteCHeader(data, m_params);
+  data.Write("const uint8_t ");
+  data.Write(m_params.fontName.c_str());
+  snprintf(buf, sizeof(buf), "[%u] =\n", (unsigned) m_fontFile.size());
+  data.Write(buf);
+
+  size_t len = m_fontFile.size();
+  size_t pos = 0;
+  while(pos < len)
+    {
+    // a line, the last escape can run 3 past the length
+    char *line = data.Reserve(C_STRING_LINE_LENGTH + 8);
+    char *p = line;
+
+    *p++ = '"';
+    while(pos < len && p - line < C_STRING_LINE_LENGTH)
+      {
+      uint8_t b = m_fontFile[pos++];
+      if(b >= 0x20 && b < 0x7f && b != '"' && b != '\\' && b != '?')
+        *p++ = (char) b;
+      else if(b == '"' || b == '\\' || b == '?')
+        {
+        // ? so ?? never starts a trigraph
+        *p++ = '\\';
+        *p++ = (char) b;
+        }
+      else if(b == '\n')
+        {
+        *p++ = '\\';
+        *p++ = 'n';
+        }
+      else
+        {
+        bool digitNext = pos < len && m_fontFile[pos] >= '0' && m_fontFile[pos] <= '7';
+        *p++ = '\\';
+        if(b >= 0100 || digitNext)
+          *p++ = hexDigits[b >> 6];
+        if(b >= 010 || digitNext)
+          *p++ = hexDigits[(b >> 3) & 7];
+        *p++ = hexDigits[b & 7];
+        }
+      }
+
+    *p++ = '"';
+    if(pos == len)
+      *p++ = ';';
+    *p++ = '\n';
+    data.Commit(p - line);
+    }
+
+  if(len == 0)
+    data.Write("\"\";\n");
+
+  WriteCLength(data, m_params, len);
+
+  if(!data.Close())
+    return Fail("Cannot write the output file");
+
+  return true;
+  }
+
+static const char base64Chars[] = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+
+// base64 lines are 64 characters, the same as CRYPT_STRING_BASE64
+#define BASE64_LINE_LENGTH 64
+
+bool FontBuilder::WriteBase64OutputFile(const std::string &dataName)
+  {
+  OutputSink data;
+  if(!data.Open(dataName, false))
+    return Fail("Cannot create the output file");
+
+  // each line encodes 48 bytes, the last is padded with =
+  const uint8_t *src = m_fontFile.empty() ? NULL : &m_fontFile[0];
+  size_t len = m_fontFile.size();
+  for(size_t i = 0; i < len; i += BASE64_LINE_LENGTH / 4 * 3)
+    {
+    size_t end = std::min(i + BASE64_LINE_LENGTH / 4 * 3, len);
+    char *line = data.Reserve(BASE64_LINE_LENGTH + 1);
+    char *p = line;
+
+    size_t n;
+    for(n = i; n + 3 <= end; n += 3)
+      {
+      uint32_t triple = (src[n] << 16) | (src[n + 1] << 8) | src[n + 2];
+      p[0] = base64Chars[triple >> 18];
+      p[1] = base64Chars[(triple >> 12) & 0x3f];
+      p[2] = base64Chars[(triple >> 6) & 0x3f];
+      p[3] = base64Chars[triple & 0x3f];
+      p += 4;
+      }
+
+    if(n < end)
+      {
+      uint32_t triple = src[n] << 16;
+      if(n + 1 < end)
+        triple |= src[n + 1] << 8;
+
+      p[0] = base64Chars[triple >> 18];
+      p[1] = base64Chars[(triple >> 12) & 0x3f];
+      p[2] = n + 1 < end ? base64Chars[(triple >> 6) & 0x3f] : '=';
+      p[3] = '=';
+      p += 4;
+      }
+
+    *p++ = '\n';
+    data.Commit(p - line);
+    }
+
+  if(!data.Close())
+    return Fail("Cannot write the output file");
+
+  return true;
+  }
+
+bool FontBuilder::WriteBinaryOutputFile(const std::string &dataName)
+  {
+  OutputSink data;
+  if(!data.Open(dataName, true))
+    return Fail("Cannot create the output file");
+
+  data.Write(m_fontFile.empty() ? NULL : &m_fontFile[0], m_fontFile.size());
+
+  if(!data.Close())
+    return Fail("Cannot write the output file");
+
+  return true;
+  }
+
+// decompress a record of a CFNT directory, page by page if it is paged
+static bool ReadDirectoryRecord(const FontFileView &file, uint8_t fontNum, std::vector<uint8_t> &record)
+  {
+  FontDirectoryEntry entry;
+  if(!file.DirectoryEntry(fontNum, entry) || entry.rawLength == 0)
+    return false;
+
+  record.resize(entry.rawLength);
+  const uint8_t *src = file.Data() + entry.offset;
+  if(entry.numPages <= 1)
+    return FontDecompress(entry.codec, src, entry.compressedLength, &record[0], entry.rawLength);
+
+  uint32_t pageSize = file.PageSize();
+  uint32_t used = entry.numPages * 4;
+  for(uint32_t page = 0; page < entry.numPages; page++)
+    {
+    uint32_t length = FontGetBigEndian(src + page * 4, 4);
+    uint32_t raw = std::min(pageSize, entry.rawLength - page * pageSize);
+    if(used + length > entry.compressedLength ||
+       !FontDecompress(entry.codec, src + used, length, &record[page * pageSize], raw))
+      return false;
+
+    used += length;
+    }
+
+  return true;
+  }
+
+bool FontBuilder::VerifyFontFile()
+  {
+  if(m_fontFile.empty() || m_glyphHashes.empty())
+    return Fail("There is no font file to verify");
+
+  FontFileView file(&m_fontFile[0], m_fontFile.size());
+  if(!file.IsValid() || file.NumFonts() != m_glyphHashes.size())
+    return Fail("The font file header does not read back");
+
+  std::vector<uint32_t> chars;
+  if(!FontParams::ParseCharSet(m_params.charSet, chars, m_strError))
+    return false;
+
+  int version = file.Version();
+  FontAccelView accel = file.Accel();
+
+  // the records of a CFNT file without a directory are one stream
+  std::vector<uint8_t> records;
+  uint32_t pos = file.RecordsOffset();
+  if(file.IsCompressed() && !file.HasDirectory())
+    {
+    records.resize(file.FileLength() - pos);
+    if(!FontDecompress(file.Codec(), &m_fontFile[pos], m_fontFile.size() - pos, &records[0], records.size()))
+      return Fail("The compressed records do not read back");
+
+    pos = 0;
+    }
+
+  std::vector<uint8_t> buffer;
+  for(uint8_t fontNum = 0; fontNum < file.NumFonts(); fontNum++)
+    {
+    FontRecordView record;
+    if(file.HasDirectory())
+      {
+      if(!ReadDirectoryRecord(file, fontNum, buffer))
+        return Fail("A compressed record does not read back");
+
+      record = FontRecordView(&buffer[0], (uint32_t) buffer.size(), version);
+      }
+    else if(file.IsCompressed())
+      {
+      record = FontRecordView(&records[pos], (uint32_t)(records.size() - pos), version);
+      pos += record.Length();
+      }
+    else
+      record = file.Record(fontNum);
+
+    if(!record.IsValid())
+      return Fail("A font record does not read back");
+
+    // the metrics arrays hold the upright placement of the size
+    FontMetricsView metrics;
+    if(!record.IsRotated())
+      metrics = file.FindMetrics(record.PixelSize());
+
+    for(size_t c = 0; c < chars.size(); c++)
+      {
+      FontGlyphView glyph = record.FindGlyph(chars[c]);
+      if(!glyph.IsValid())
+        return Fail("A character of the font has no glyph");
+
+      if(accel.IsValid() && record.FindGlyph(chars[c], accel).Glyph() != glyph.Glyph())
+        return Fail("The lookup table finds another glyph");
+
+      uint16_t numBytes = GlyphLength(glyph.Glyph(), record.BitsPerPixel(), record.HasEncodedGlyphs());
+      if((const uint8_t *) glyph.Glyph() - record.Data() + numBytes > record.Length() ||
+         HashGlyph(glyph.Glyph(), numBytes) != m_glyphHashes[fontNum][c])
+        return Fail("A glyph does not read back as it was built");
+
+      if(metrics.IsValid())
+        {
+        int32_t slot = record.CharSlot(chars[c]);
+        if(slot < 0 || metrics.Advance(slot) != glyph.Advance() || metrics.Baseline(slot) != glyph.Baseline() ||
+           metrics.Offset(slot) != glyph.Offset() || metrics.Width(slot) != glyph.Width() ||
+           metrics.Height(slot) != glyph.Height())
+          return Fail("The glyph metrics do not match the glyph");
+        }
+      }
+    }
+
+  return true;
+  }
+
+// append a JSON string, quoted and escaped
+static void PutJsonString(std::string &json, const std::string &str)
+  {
+  json += '"';
+  for(size_t i = 0; i < str.length(); i++)
+    {
+    unsigned char c = (unsigned char) str[i];
+    if(c == '"' || c == '\\')
+      {
+      json += '\\';
+      json += (char) c;
+      }
+    else if(c < 0x20)
+      {
+      char buf[8];
+      snprintf(buf, sizeof(buf), "\\u%04x", c);
+      json += buf;
+      }
+    else
+      json += (char) c;
+    }
+  json += '"';
+  }
+
+// uncompressed bytes for each compressed byte, null if not compressed
+static void PutJsonRatio(std::string &json, uint32_t rawBytes, uint32_t compressedBytes)
+  {
+  char buf[32];
+  if(compressedBytes == 0)
+    json += "null";
+  else
+    {
+    snprintf(buf, sizeof(buf), "%.3f", (double) rawBytes / compressedBytes);
+    json += buf;
+    }
+  }
+
+void FontBuilder::FormatJsonReport(const std::string &outputName, std::string &json) const
+  {
+  char buf[256];
+  const FontReport &r = m_report;
+
+  json += "{\n    \"output\": ";
+  PutJsonString(json, outputName);
+  json += ",\n    \"name\": ";
+  PutJsonString(json, m_params.fontName);
+  json += ",\n    \"face\": ";
+  PutJsonString(json, m_params.fontFace);
+
+  snprintf(buf, sizeof(buf), ",\n    \"format\": %d,\n    \"bitsPerPixel\": %d,\n    \"fileBytes\": %u,\n    \"codec\": ",
+    r.version, m_params.bitsPerPixel, (unsigned) m_fontFile.size());
+  json += buf;
+  if(r.codec == FONT_CODEC_PER_RECORD)
+    json += "\"per record\"";
+  else if(r.codec >= 0)
+    PutJsonString(json, FontCodecName(r.codec));
+  else
+    json += "null";
+
+  snprintf(buf, sizeof(buf), ",\n    \"recordBytes\": %u,\n    \"compressedBytes\": %u,\n    \"compressionRatio\": ",
+    r.recordBytes, r.compressedBytes);
+  json += buf;
+  PutJsonRatio(json, r.recordBytes, r.compressedBytes);
+
+  snprintf(buf, sizeof(buf), ",\n    \"sectionBytes\": %u,\n    \"paddingBytes\": %u,\n    \"glyphs\": %u,\n"
+    "    \"sharedGlyphs\": %u,\n    \"sharedBytes\": %u,\n    \"runGlyphs\": %u,\n    \"cachedGlyphs\": %u,\n",
+    r.sectionBytes, r.paddingBytes, r.glyphs, r.sharedGlyphs, r.sharedBytes, r.runGlyphs, r.cachedGlyphs);
+  json += buf;
+  snprintf(buf, sizeof(buf), "    \"charMaps\": %u,\n    \"mapHoles\": %u,\n", r.charMaps, r.mapHoles);
+  json += buf;
+
+  // milliseconds, the render and pack times are summed over the threads
+  snprintf(buf, sizeof(buf), "    \"stageMs\": { \"render\": %.3f, \"pack\": %.3f, \"assemble\": %.3f, "
+    "\"compress\": %.3f, \"write\": %.3f },\n", r.renderSeconds * 1000, r.packSeconds * 1000,
+    r.assembleSeconds * 1000, r.compressSeconds * 1000, r.writeSeconds * 1000);
+  json += buf;
+
+  json += "    \"records\": [";
+  for(size_t n = 0; n < m_recordReports.size(); n++)
+    {
+    const RecordReport &rec = m_recordReports[n];
+
+    snprintf(buf, sizeof(buf), "%s\n      {\n        \"size\": %d,\n        \"angle\": %d,\n        \"glyphs\": %u,\n"
+      "        \"sharedGlyphs\": %u,\n", n > 0 ? "," : "", rec.pixels, rec.angle, rec.glyphs, rec.sharedGlyphs);
+    json += buf;
+    snprintf(buf, sizeof(buf), "        \"recordBytes\": %u,\n        \"headerBytes\": %u,\n        \"mapBytes\": %u,\n"
+      "        \"bitmapBytes\": %u,\n        \"paddingBytes\": %u,\n", rec.recordBytes, rec.headerBytes,
+      rec.mapBytes, rec.bitmapBytes, rec.paddingBytes);
+    json += buf;
+
+    // a record only has its own compressed length behind a directory
+    json += "        \"compressedBytes\": ";
+    if(rec.compressedBytes == 0)
+      json += "null";
+    else
+      {
+      snprintf(buf, sizeof(buf), "%u", rec.compressedBytes);
+      json += buf;
+      }
+    json += ",\n        \"compressionRatio\": ";
+    PutJsonRatio(json, rec.recordBytes, rec.compressedBytes);
+
+    snprintf(buf, sizeof(buf), ",\n        \"stageMs\": { \"render\": %.3f, \"pack\": %.3f },\n        \"largestGlyphs\": [",
+      rec.renderSeconds * 1000, rec.packSeconds * 1000);
+    json += buf;
+    for(uint32_t i = 0; i < rec.numLargest; i++)
+      {
+      snprintf(buf, sizeof(buf), "%s{ \"char\": \"U+%04X\", \"bytes\": %u }", i > 0 ? ", " : " ",
+        rec.largestChars[i], rec.largestBytes[i]);
+      json += buf;
+      }
+    json += rec.numLargest > 0 ? " ]\n      }" : "]\n      }";
+    }
+
+  json += m_recordReports.empty() ? "]\n  }" : "\n    ]\n  }";
+  }
+
+bool FontBuilder::WriteOutputFile(const std::string &fileName)
+  {
+  std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+  bool written;
+
+  switch(m_params.outputType)
+    {
+    case OUTPUT_C:
+      written = WriteCOutputFile(fileName);
+      break;
+    case OUTPUT_C_STRING:
+      written = WriteCStringOutputFile(fileName);
+      break;
+    case OUTPUT_BASE64:
+      written = WriteBase64OutputFile(fileName);
+      break;
+    default:
+      written = WriteBinaryOutputFile(fileName);
+      break;
+    }
+
+  m_report.writeSeconds = SecondsSince(start);
+  return written;
+  }
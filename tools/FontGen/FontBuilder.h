@@ -0,0 +1,253 @@
+// FontBuilder.h : UI-free raster font generator
+//
+// Used by the FontGen dialog and by the FontGenCmd command line tool.
+//
+
+#if !defined(FONTGEN_FONTBUILDER_H)
+#define FONTGEN_FONTBUILDER_H
+
+#if _MSC_VER > 1000
+#pragma once
+#endif // _MSC_VER > 1000
+
+#include <stdint.h>
+#include <string.h>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "FontFormat.h"
+
+class FontRasterizer;
+class CharMap;
+class SizeGlyphs;
+struct RecordLayout;
+struct GenerateState;
+
+// Type of output, 0=c, 1=base64, 2=binary, 3=c string
+enum FontOutputType
+  {
+  OUTPUT_C = 0,
+  OUTPUT_BASE64 = 1,
+  OUTPUT_BINARY = 2,
+  OUTPUT_C_STRING = 3,        // C source with the font as one string literal
+  };
+
+// how a CFNT codec is chosen, or one of the FONT_CODEC_ values
+enum FontCodecChoice
+  {
+  CODEC_DEFAULT = -1,         // XPRESS_HUFF on Windows, LZ4 elsewhere
+  CODEC_SMALLEST = -2,        // try every codec, keep the smallest
+  CODEC_FASTEST = -3,         // the fastest to decode of those near the smallest
+  };
+
+// what the char maps are partitioned for
+enum FontMapPartition
+  {
+  MAPS_SIZE = 0,              // the smallest char map table
+  MAPS_LOOKUP = 1,            // fewer maps to walk, at the cost of some null offsets
+  };
+
+// everything needed to build a font file
+struct FontParams
+  {
+  std::string fontFace;       // face to render
+  std::string fontName;       // name embedded into the font (16 chars)
+  std::string charSet;        // characters to generate, UTF-8 with U+XXXX (four hex digits) or
+                              // U+{X} (one to six) escapes and U+XXXX-U+YYYY ranges
+  std::vector<int> sizes;     // pixel sizes to generate
+  long fontWeight;
+  bool italic;
+  bool underline;
+  int outputType;             // FontOutputType
+  int rasterizer;             // RasterizerType
+  int threads;                // render threads, 0 = one per processor
+  int bitsPerPixel;           // glyph coverage depth, 1, 2, 4 or 8
+  bool shareGlyphs;           // identical glyphs in a record share one glyph record
+  int formatVersion;          // 0 = v1 unless the font needs v2, 1 or 2 to force it
+  int alignment;              // char map and glyph alignment, 1, 2, 4 or 16
+  int codec;                  // CFNT codec, FontCodecChoice or FONT_CODEC_
+  bool recordDirectory;       // compress each CFNT record on its own behind a directory
+  uint32_t pageSize;          // split directory records into pages, 0 for none
+  bool accelTable;            // add the glyph lookup table section
+  int mapPartition;           // FontMapPartition
+  bool runLengthGlyphs;       // store 1 bit glyphs as row runs when that is smaller
+  std::vector<int> tapeSizes; // pixel sizes that get a digit tape section
+  bool metricsTable;          // add the glyph metrics arrays section
+  int startAngle;             // first angle of the rotated glyph sets
+  int stepAngle;              // degrees between the rotated sets, 0 for none
+  int endAngle;               // the sets stop before this angle, at most a turn past the start
+  std::string cacheDir;       // rendered glyphs are kept here between builds, empty for none
+
+  FontParams()
+    {
+    charSet = DefaultCharSet();
+    fontWeight = 0;
+    italic = false;
+    underline = false;
+    outputType = OUTPUT_C;
+    rasterizer = 0;
+    threads = 0;
+    bitsPerPixel = 1;
+    shareGlyphs = true;
+    formatVersion = 0;
+    alignment = FONT_ALIGNMENT;
+    codec = CODEC_DEFAULT;
+    recordDirectory = false;
+    pageSize = 0;
+    accelTable = false;
+    mapPartition = MAPS_SIZE;
+    runLengthGlyphs = false;
+    metricsTable = false;
+    startAngle = 0;
+    stepAngle = 0;
+    endAngle = 360;
+    }
+
+  static const char *DefaultCharSet();
+  // the sorted code points of a character set, false and an error if it
+  // is not valid
+  static bool ParseCharSet(const std::string &charSet, std::vector<uint32_t> &chars, std::string &error);
+  };
+
+// what went into the last generated font
+struct FontReport
+  {
+  uint32_t glyphs;            // characters in all of the records
+  uint32_t charMaps;          // char maps in each record
+  uint32_t mapHoles;          // null offsets in the char maps of each record
+  uint32_t sharedGlyphs;      // characters that share another glyph record
+  uint32_t sharedBytes;       // glyph record bytes saved by sharing
+  uint32_t runGlyphs;         // glyph records stored as row runs
+  uint32_t paddingBytes;      // bytes added to align the char maps and glyphs
+  uint32_t recordBytes;       // uncompressed length of the font records
+  int version;                // format the font was written in
+  int codec;                  // codec of a CFNT font, -1 for FONT
+  uint32_t compressedBytes;   // length of the compressed records, with the directory
+  uint32_t pages;             // compressed blocks of a CFNT font
+  uint32_t sectionBytes;      // length of the file sections
+  uint32_t rotatedRecords;    // records of turned glyphs
+  uint32_t cachedGlyphs;      // glyphs read from the glyph cache instead of rendered
+  // seconds in each stage, rendering and packing are summed over the threads
+  double renderSeconds;       // rasterizing the glyphs
+  double packSeconds;         // trimming, packing and encoding the glyph records
+  double assembleSeconds;     // char maps, records and sections
+  double compressSeconds;
+  double writeSeconds;        // formatting and writing the output file
+  };
+
+// the largest glyphs reported for each record
+#define REPORT_LARGEST_GLYPHS   5
+
+// what went into one record of the last generated font.  The header, map,
+// bitmap and padding bytes add up to the record bytes
+struct RecordReport
+  {
+  int pixels;                 // pixel size
+  int angle;                  // degrees the glyphs are turned
+  uint32_t glyphs;            // characters in the record
+  uint32_t sharedGlyphs;      // characters that share another glyph record
+  uint32_t headerBytes;       // the record header and the glyph headers
+  uint32_t mapBytes;          // the char map headers and offsets
+  uint32_t bitmapBytes;       // glyph pixels or row runs
+  uint32_t paddingBytes;      // bytes added to align the char maps and glyphs
+  uint32_t recordBytes;       // uncompressed length of the record
+  uint32_t compressedBytes;   // length of a record compressed on its own, 0 if not
+  double renderSeconds;       // summed over the threads like the FontReport times
+  double packSeconds;
+  uint32_t numLargest;
+  uint32_t largestChars[REPORT_LARGEST_GLYPHS];  // the biggest glyph records, largest first
+  uint32_t largestBytes[REPORT_LARGEST_GLYPHS];  // and their lengths without padding
+
+  RecordReport()
+    {
+    memset(this, 0, sizeof(*this));
+    }
+  };
+
+class FontBuilder
+  {
+public:
+  FontBuilder(const FontParams &params);
+  ~FontBuilder();
+
+  // generate a font file using the rasterizer the params select
+  bool GenerateFontFile();
+  // generate a font file from glyphs rendered by the rasterizer, on the
+  // calling thread
+  bool GenerateFontFile(FontRasterizer &rasterizer);
+  // generate the font files of several builders with one pool of render
+  // threads, 0 for one per processor.  Returns false if any of them
+  // failed, each builder has its own error
+  static bool GenerateFontFiles(const std::vector<FontBuilder *> &builders, int threads);
+  bool WriteCOutputFile(const std::string &fileName);
+  bool WriteCStringOutputFile(const std::string &fileName);
+  bool WriteBase64OutputFile(const std::string &fileName);
+  bool WriteBinaryOutputFile(const std::string &fileName);
+  // write the generated font using the output type of the params
+  bool WriteOutputFile(const std::string &fileName);
+  // read the generated font back as a renderer does and check that every
+  // character finds the glyph it was built with, byte for byte
+  bool VerifyFontFile();
+
+  // extension used by the output type (.c, .txt or .fon)
+  static const char *OutputExtension(int outputType);
+
+  const std::vector<uint8_t> &FontFile() const { return m_fontFile; }
+  // reason the last operation failed
+  const std::string &Error() const { return m_strError; }
+  // a problem that did not stop the last build, such as a glyph cache
+  // that could not be written.  Empty if there was none
+  const std::string &Warning() const { return m_strWarning; }
+  const FontReport &Report() const { return m_report; }
+  // what went into each record, in file order
+  const std::vector<RecordReport> &RecordReports() const { return m_recordReports; }
+  // append the report of the last generated font as a JSON object
+  void FormatJsonReport(const std::string &outputName, std::string &json) const;
+
+protected:
+  bool Fail(const char *msg);
+  bool Fail(const std::string &msg) { return Fail(msg.c_str()); }
+  // render with the rasterizer, or with one rasterizer for each of the
+  // threads if it is NULL
+  bool Generate(FontRasterizer *rasterizer, int threads);
+  // a build is begun, its batches of glyphs rendered on any threads and
+  // then ended to assemble the file
+  bool BeginGenerate(FontRasterizer *rasterizer, int threads);
+  size_t NumBatches() const;
+  void RenderBatch(size_t item, int worker);
+  bool EndGenerate();
+  void BuildCharMaps(int version, const std::vector<uint32_t> &chars, std::vector<CharMap> &charMaps);
+  // share identical glyphs and lay out the glyph records of each size
+  void ShareGlyphs(const std::vector<uint32_t> &chars, const std::vector<SizeGlyphs> &sizes,
+    std::vector<RecordLayout> &layouts);
+  uint32_t RecordsLength(int version, const std::vector<CharMap> &charMaps, const std::vector<RecordLayout> &layouts) const;
+  // write the records to out, which holds RecordsLength bytes
+  void WriteRecords(int version, const std::vector<uint32_t> &chars, const std::vector<CharMap> &charMaps,
+    const std::vector<SizeGlyphs> &sizes, const std::vector<RecordLayout> &layouts, uint8_t *out);
+  int BuildSections(int version, const std::vector<uint32_t> &chars, const std::vector<CharMap> &charMaps,
+    const std::vector<SizeGlyphs> &sizes, std::vector<uint8_t> &sections);
+  void BuildMetricsTable(const std::vector<uint32_t> &chars, const std::vector<CharMap> &charMaps,
+    const std::vector<SizeGlyphs> &sizes, std::vector<uint8_t> &metrics);
+  void BuildDigitTapes(const std::vector<uint32_t> &chars, const std::vector<SizeGlyphs> &sizes, std::vector<uint8_t> &tapes);
+  void BuildAccelTable(int version, const std::vector<CharMap> &charMaps, std::vector<uint8_t> &accel);
+  void BuildRotationTable(const std::vector<SizeGlyphs> &sizes, std::vector<uint8_t> &rotation);
+  bool CompressFontFile(const std::vector<uint8_t> &outRec, const std::vector<uint8_t> &sections, int version);
+  bool CompressPages(int codec, const uint8_t *src, size_t srcLen, std::vector<uint8_t> &compressed);
+  bool CompressBlock(const uint8_t *src, size_t srcLen, int &codec, std::vector<uint8_t> &compressed);
+
+  FontParams m_params;
+  std::vector<uint8_t> m_fontFile;
+  std::string m_strError;
+  std::string m_strWarning;
+  FontReport m_report;
+  std::vector<RecordReport> m_recordReports;
+  std::unique_ptr<GenerateState> m_state;   // between BeginGenerate and EndGenerate
+  std::vector<std::vector<uint32_t> > m_glyphHashes;  // of each character in each record
+
+private:
+  FontBuilder(const FontBuilder &);
+  FontBuilder &operator=(const FontBuilder &);
+  };
+
+#endif // !defined(FONTGEN_FONTBUILDER_H)
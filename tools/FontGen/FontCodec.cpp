@@ -0,0 +1,523 @@
+// FontCodec.cpp : compression codecs for CFNT fonts
+//
+
+#if defined(_WIN32)
+#include <windows.h>
+#include <compressapi.h>
+#endif
+
+#include <stdlib.h>
+#include <string.h>
+
+#if defined(FONTGEN_HAVE_ZLIB)
+#include <zlib.h>
+#endif
+
+#include "FontCodec.h"
+
+static const char *codecNames[FONT_NUM_CODECS] = { "xpress", "lz4", "deflate", "lzss", "none" };
+
+// the decoders in order of speed, the stored data costs nothing
+static const int codecDecodeCost[FONT_NUM_CODECS] = { 4, 1, 3, 2, 0 };
+
+bool FontCodecAvailable(int codec)
+  {
+  switch(codec)
+    {
+    case FONT_CODEC_XPRESS_HUFF:
+#if defined(_WIN32)
+      return true;
+#else
+      return false;
+#endif
+    case FONT_CODEC_DEFLATE:
+#if defined(FONTGEN_HAVE_ZLIB)
+      return true;
+#else
+      return false;
+#endif
+    case FONT_CODEC_LZ4:
+    case FONT_CODEC_LZSS:
+    case FONT_CODEC_NONE:
+      return true;
+    }
+
+  return false;
+  }
+
+const char *FontCodecName(int codec)
+  {
+  if(codec < 0 || codec >= FONT_NUM_CODECS)
+    return "unknown";
+
+  return codecNames[codec];
+  }
+
+int FontCodecFromName(const char *name)
+  {
+  for(int codec = 0; codec < FONT_NUM_CODECS; codec++)
+    if(strcmp(name, codecNames[codec]) == 0)
+      return codec;
+
+  return -1;
+  }
+
+int FontCodecDecodeCost(int codec)
+  {
+  if(codec < 0 || codec >= FONT_NUM_CODECS)
+    return FONT_NUM_CODECS;
+
+  return codecDecodeCost[codec];
+  }
+
+////////////////////////////////////////////////////////////////////////////
+// LZ4 block format.  Greedy matching with a single entry hash table, which
+// is what the reference compressor does at its fastest setting.
+
+#define LZ4_MIN_MATCH     4
+#define LZ4_LAST_LITERALS 5       // the block always ends in literals
+#define LZ4_MF_LIMIT      12      // no match starts in the last 12 bytes
+#define LZ4_HASH_BITS     12
+#define LZ4_MAX_OFFSET    65535
+
+static inline uint32_t Read32(const uint8_t *p)
+  {
+  return p[0] | (p[1] << 8) | (p[2] << 16) | ((uint32_t) p[3] << 24);
+  }
+
+static inline uint32_t Lz4Hash(uint32_t sequence)
+  {
+  return (sequence * 2654435761u) >> (32 - LZ4_HASH_BITS);
+  }
+
+// lengths of 15 or more continue in bytes of 255
+static void Lz4PutLength(std::vector<uint8_t> &dst, size_t len)
+  {
+  while(len >= 255)
+    {
+    dst.push_back(255);
+    len -= 255;
+    }
+
+  dst.push_back((uint8_t) len);
+  }
+
+// a run of literals followed by a match, matchLen is 0 for the last run
+static void Lz4PutSequence(std::vector<uint8_t> &dst, const uint8_t *literals, size_t litLen, size_t offset, size_t matchLen)
+  {
+  size_t matchCode = matchLen > 0 ? matchLen - LZ4_MIN_MATCH : 0;
+
+  dst.push_back((uint8_t)(((litLen < 15 ? litLen : 15) << 4) | (matchCode < 15 ? matchCode : 15)));
+
+  if(litLen >= 15)
+    Lz4PutLength(dst, litLen - 15);
+
+  dst.insert(dst.end(), literals, literals + litLen);
+
+  if(matchLen == 0)
+    return;
+
+  dst.push_back((uint8_t) offset);
+  dst.push_back((uint8_t)(offset >> 8));
+
+  if(matchCode >= 15)
+    Lz4PutLength(dst, matchCode - 15);
+  }
+
+static void Lz4Compress(const uint8_t *src, size_t srcLen, std::vector<uint8_t> &dst)
+  {
+  std::vector<int32_t> table(1 << LZ4_HASH_BITS, -1);
+  size_t anchor = 0;
+  size_t ip = 0;
+
+  if(srcLen > LZ4_MF_LIMIT)
+    {
+    size_t matchLimit = srcLen - LZ4_LAST_LITERALS;
+    size_t ipLimit = srcLen - LZ4_MF_LIMIT;
+
+    while(ip < ipLimit)
+      {
+      uint32_t sequence = Read32(src + ip);
+      uint32_t hash = Lz4Hash(sequence);
+      int32_t ref = table[hash];
+      table[hash] = (int32_t) ip;
+
+      if(ref < 0 || ip - ref > LZ4_MAX_OFFSET || Read32(src + ref) != sequence)
+        {
+        ip++;
+        continue;
+        }
+
+      size_t matchLen = LZ4_MIN_MATCH;
+      while(ip + matchLen < matchLimit && src[ref + matchLen] == src[ip + matchLen])
+        matchLen++;
+
+      Lz4PutSequence(dst, src + anchor, ip - anchor, ip - ref, matchLen);
+
+      ip += matchLen;
+      anchor = ip;
+
+      // the position before the next one is often the start of a match
+      if(ip - 2 < ipLimit)
+        table[Lz4Hash(Read32(src + ip - 2))] = (int32_t)(ip - 2);
+      }
+    }
+
+  Lz4PutSequence(dst, src + anchor, srcLen - anchor, 0, 0);
+  }
+
+// read a length continued in bytes of 255
+static bool Lz4GetLength(const uint8_t *src, size_t srcLen, size_t &ip, size_t &len)
+  {
+  uint8_t b;
+  do
+    {
+    if(ip >= srcLen)
+      return false;
+
+    b = src[ip++];
+    len += b;
+    } while(b == 255);
+
+  return true;
+  }
+
+static bool Lz4Decompress(const uint8_t *src, size_t srcLen, uint8_t *dst, size_t dstLen)
+  {
+  size_t ip = 0;
+  size_t op = 0;
+
+  while(ip < srcLen)
+    {
+    uint8_t token = src[ip++];
+
+    size_t litLen = token >> 4;
+    if(litLen == 15 && !Lz4GetLength(src, srcLen, ip, litLen))
+      return false;
+
+    if(litLen > srcLen - ip || litLen > dstLen - op)
+      return false;
+
+    memcpy(dst + op, src + ip, litLen);
+    ip += litLen;
+    op += litLen;
+
+    // the last sequence has no match
+    if(ip == srcLen)
+      break;
+
+    if(srcLen - ip < 2)
+      return false;
+
+    size_t offset = src[ip] | (src[ip + 1] << 8);
+    ip += 2;
+
+    size_t matchLen = token & 15;
+    if(matchLen == 15 && !Lz4GetLength(src, srcLen, ip, matchLen))
+      return false;
+
+    matchLen += LZ4_MIN_MATCH;
+
+    if(offset == 0 || offset > op || matchLen > dstLen - op)
+      return false;
+
+    // matches can overlap the bytes they produce
+    for(size_t i = 0; i < matchLen; i++, op++)
+      dst[op] = dst[op - offset];
+    }
+
+  return op == dstLen;
+  }
+
+////////////////////////////////////////////////////////////////////////////
+// LZSS with a 4k window.  Each flag byte describes the next 8 items, lsb
+// first, a set bit is a literal byte.  A match is 2 bytes, 12 bits of
+// distance - 1 then 4 bits of length - 3.  The decoder only needs the
+// output it has already written so it runs in a few bytes of RAM.
+
+#define LZSS_WINDOW       4096
+#define LZSS_MIN_MATCH    3
+#define LZSS_MAX_MATCH    (15 + LZSS_MIN_MATCH)
+#define LZSS_HASH_BITS    12
+#define LZSS_MAX_CHAIN    128       // candidates tried for each position
+
+static inline uint32_t LzssHash(const uint8_t *p)
+  {
+  return ((p[0] << 8) ^ (p[1] << 4) ^ p[2]) & ((1 << LZSS_HASH_BITS) - 1);
+  }
+
+static void LzssCompress(const uint8_t *src, size_t srcLen, std::vector<uint8_t> &dst)
+  {
+  std::vector<int32_t> head(1 << LZSS_HASH_BITS, -1);
+  std::vector<int32_t> prev(srcLen, -1);
+
+  size_t flagPos = 0;
+  int items = 0;
+  size_t ip = 0;
+
+  while(ip < srcLen)
+    {
+    if((items & 7) == 0)
+      {
+      flagPos = dst.size();
+      dst.push_back(0);
+      }
+
+    size_t bestLen = 0;
+    size_t bestDist = 0;
+
+    if(srcLen - ip >= LZSS_MIN_MATCH)
+      {
+      size_t maxLen = srcLen - ip < LZSS_MAX_MATCH ? srcLen - ip : LZSS_MAX_MATCH;
+      int32_t ref = head[LzssHash(src + ip)];
+
+      for(int chain = 0; ref >= 0 && chain < LZSS_MAX_CHAIN && ip - ref <= LZSS_WINDOW; chain++)
+        {
+        size_t len = 0;
+        while(len < maxLen && src[ref + len] == src[ip + len])
+          len++;
+
+        if(len > bestLen)
+          {
+          bestLen = len;
+          bestDist = ip - ref;
+          if(len == maxLen)
+            break;
+          }
+
+        ref = prev[ref];
+        }
+      }
+
+    size_t advance;
+    if(bestLen >= LZSS_MIN_MATCH)
+      {
+      size_t code = bestDist - 1;
+      dst.push_back((uint8_t)(code >> 4));
+      dst.push_back((uint8_t)(((code & 15) << 4) | (bestLen - LZSS_MIN_MATCH)));
+      advance = bestLen;
+      }
+    else
+      {
+      dst[flagPos] |= (uint8_t)(1 << (items & 7));
+      dst.push_back(src[ip]);
+      advance = 1;
+      }
+
+    items++;
+
+    // add every position covered to the hash chains
+    for(; advance > 0; advance--, ip++)
+      {
+      if(srcLen - ip >= LZSS_MIN_MATCH)
+        {
+        uint32_t hash = LzssHash(src + ip);
+        prev[ip] = head[hash];
+        head[hash] = (int32_t) ip;
+        }
+      }
+    }
+  }
+
+static bool LzssDecompress(const uint8_t *src, size_t srcLen, uint8_t *dst, size_t dstLen)
+  {
+  size_t ip = 0;
+  size_t op = 0;
+
+  while(op < dstLen)
+    {
+    if(ip >= srcLen)
+      return false;
+
+    uint8_t flags = src[ip++];
+
+    for(int bit = 0; bit < 8 && op < dstLen; bit++)
+      {
+      if((flags & (1 << bit)) != 0)
+        {
+        if(ip >= srcLen)
+          return false;
+
+        dst[op++] = src[ip++];
+        continue;
+        }
+
+      if(srcLen - ip < 2)
+        return false;
+
+      size_t dist = ((src[ip] << 4) | (src[ip + 1] >> 4)) + 1;
+      size_t len = (src[ip + 1] & 15) + LZSS_MIN_MATCH;
+      ip += 2;
+
+      if(dist > op || len > dstLen - op)
+        return false;
+
+      for(size_t i = 0; i < len; i++, op++)
+        dst[op] = dst[op - dist];
+      }
+    }
+
+  return ip == srcLen;
+  }
+
+////////////////////////////////////////////////////////////////////////////
+// XPRESS_HUFF through the Windows compression API
+
+#if defined(_WIN32)
+static bool XpressCompress(const uint8_t *src, size_t srcLen, std::vector<uint8_t> &dst, std::string &error)
+  {
+  // calculate the compressed size.
+  COMPRESSOR_HANDLE Compressor = NULL;
+  SIZE_T CompressedDataSize, CompressedBufferSize;
+
+  BOOL Success = CreateCompressor(
+    COMPRESS_ALGORITHM_XPRESS_HUFF, //  Compression Algorithm
+    NULL,                           //  Optional allocation routine
+    &Compressor);                   //  Handle
+                                    //  Query compressed buffer size.
+  if(!Success)
+    {
+    error = "Cannot create the compressor";
+    return false;
+    }
+
+  Success = Compress(
+    Compressor,                  //  Compressor Handle
+    (PVOID) src,                 //  Input buffer, Uncompressed data
+    srcLen,                      //  Uncompressed data size
+    NULL,                        //  Compressed Buffer
+    0,                           //  Compressed Buffer size
+    &CompressedBufferSize);      //  Compressed Data size
+
+                                  //  Allocate memory for compressed buffer.
+  if(!Success)
+    {
+    DWORD ErrorCode = GetLastError();
+
+    if(ErrorCode != ERROR_INSUFFICIENT_BUFFER)
+      {
+      CloseCompressor(Compressor);
+      error = "Cannot compress font record";
+      return false;
+      }
+    }
+
+  dst.resize(CompressedBufferSize);
+
+  //  Call Compress() again to do real compression and output the compressed
+  //  data to CompressedBuffer.
+  Success = Compress(
+    Compressor,             //  Compressor Handle
+    (PVOID) src,            //  Input buffer, Uncompressed data
+    srcLen,                 //  Uncompressed data size
+    &dst[0],                //  Compressed Buffer
+    CompressedBufferSize,   //  Compressed Buffer size
+    &CompressedDataSize);   //  Compressed Data size
+
+  CloseCompressor(Compressor);
+
+  if(!Success)
+    {
+    dst.clear();
+    error = "Cannot compress data";
+    return false;
+    }
+
+  dst.resize(CompressedDataSize);
+  return true;
+  }
+
+static bool XpressDecompress(const uint8_t *src, size_t srcLen, uint8_t *dst, size_t dstLen)
+  {
+  DECOMPRESSOR_HANDLE Decompressor = NULL;
+
+  if(!CreateDecompressor(COMPRESS_ALGORITHM_XPRESS_HUFF, NULL, &Decompressor))
+    return false;
+
+  SIZE_T DecompressedDataSize = 0;
+  BOOL Success = Decompress(Decompressor, (PVOID) src, srcLen, dst, dstLen, &DecompressedDataSize);
+
+  CloseDecompressor(Decompressor);
+
+  return Success && DecompressedDataSize == dstLen;
+  }
+#endif
+
+////////////////////////////////////////////////////////////////////////////
+
+bool FontCompress(int codec, const uint8_t *src, size_t srcLen, std::vector<uint8_t> &dst, std::string &error)
+  {
+  dst.clear();
+
+  if(!FontCodecAvailable(codec))
+    {
+    error = std::string("The ") + FontCodecName(codec) + " codec is not available in this build";
+    return false;
+    }
+
+  switch(codec)
+    {
+#if defined(_WIN32)
+    case FONT_CODEC_XPRESS_HUFF:
+      return XpressCompress(src, srcLen, dst, error);
+#endif
+    case FONT_CODEC_LZ4:
+      Lz4Compress(src, srcLen, dst);
+      return true;
+#if defined(FONTGEN_HAVE_ZLIB)
+    case FONT_CODEC_DEFLATE:
+      {
+      uLongf dstLen = compressBound((uLong) srcLen);
+      dst.resize(dstLen);
+      if(compress2(&dst[0], &dstLen, src, (uLong) srcLen, Z_BEST_COMPRESSION) != Z_OK)
+        {
+        dst.clear();
+        error = "Cannot deflate the font";
+        return false;
+        }
+
+      dst.resize(dstLen);
+      return true;
+      }
+#endif
+    case FONT_CODEC_LZSS:
+      LzssCompress(src, srcLen, dst);
+      return true;
+    case FONT_CODEC_NONE:
+      dst.assign(src, src + srcLen);
+      return true;
+    }
+
+  error = "Unknown codec";
+  return false;
+  }
+
+bool FontDecompress(int codec, const uint8_t *src, size_t srcLen, uint8_t *dst, size_t dstLen)
+  {
+  switch(codec)
+    {
+#if defined(_WIN32)
+    case FONT_CODEC_XPRESS_HUFF:
+      return XpressDecompress(src, srcLen, dst, dstLen);
+#endif
+    case FONT_CODEC_LZ4:
+      return Lz4Decompress(src, srcLen, dst, dstLen);
+#if defined(FONTGEN_HAVE_ZLIB)
+    case FONT_CODEC_DEFLATE:
+      {
+      uLongf len = (uLongf) dstLen;
+      return uncompress(dst, &len, src, (uLong) srcLen) == Z_OK && len == dstLen;
+      }
+#endif
+    case FONT_CODEC_LZSS:
+      return LzssDecompress(src, srcLen, dst, dstLen);
+    case FONT_CODEC_NONE:
+      if(srcLen != dstLen)
+        return false;
+
+      memcpy(dst, src, dstLen);
+      return true;
+    }
+
+  return false;
+  }
@@ -0,0 +1,37 @@
+// FontCodec.h : compression codecs for CFNT fonts
+//
+// XPRESS_HUFF is the original CFNT codec and needs the Windows
+// compression API.  LZ4 and LZSS are built in, deflate uses zlib when
+// FontGen is built with FONTGEN_HAVE_ZLIB.
+//
+
+#if !defined(FONTGEN_FONTCODEC_H)
+#define FONTGEN_FONTCODEC_H
+
+#if _MSC_VER > 1000
+#pragma once
+#endif // _MSC_VER > 1000
+
+#include <stddef.h>
+#include <stdint.h>
+#include <string>
+#include <vector>
+
+#include "FontFormat.h"
+
+// true if the codec can be used by this build
+bool FontCodecAvailable(int codec);
+// short name of a codec as used on the command line
+const char *FontCodecName(int codec);
+// codec with the name, -1 if there is none
+int FontCodecFromName(const char *name);
+// relative cost of decoding with the codec, lower is faster
+int FontCodecDecodeCost(int codec);
+
+// compress src, replacing the contents of dst
+bool FontCompress(int codec, const uint8_t *src, size_t srcLen, std::vector<uint8_t> &dst, std::string &error);
+// decompress exactly dstLen bytes into dst.  Returns false if the data is
+// not valid for the codec or does not decode to dstLen bytes
+bool FontDecompress(int codec, const uint8_t *src, size_t srcLen, uint8_t *dst, size_t dstLen);
+
+#endif // !defined(FONTGEN_FONTCODEC_H)
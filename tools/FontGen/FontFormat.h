@@ -0,0 +1,294 @@
+// FontFormat.h : layout of the FONT/CFNT raster font stream
+//
+
+#if !defined(FONTGEN_FONTFORMAT_H)
+#define FONTGEN_FONTFORMAT_H
+
+#if _MSC_VER > 1000
+#pragma once
+#endif // _MSC_VER > 1000
+
+#include <stdint.h>
+
+// A raster font stream is defined as the following format
+//
+// uint32_t magic	                  // can be:
+                                    // FONT - non compressed binary font image
+                                    // CFNT - compressed binary image
+// char name[REG_NAME_MAX]          // name of the font. (16 chars)
+// uint16_t file_length;            // un-compressed file length, 0 in v2
+// uint8_t num_fonts               // number of fixed size fonts
+// uint8_t version                 // 0 for v1, 2 for v2
+// -- v1 --
+// uint8_t reserved[4]
+// -- v2 --
+// uint32_t file_length             // un-compressed file length
+// --
+// uint8_t codec                   // compression of a CFNT file, 0 is XPRESS_HUFF
+// uint8_t flags                   // FONT_FLAG_
+// uint8_t page_shift              // log2 of the page size of a directory, 0 for none
+// uint8_t num_sections            // file sections after the header and directory
+// -- a CFNT file with FONT_FLAG_DIRECTORY has a directory entry for each record --
+// uint8_t size                    // pixel size of the record
+// uint8_t codec                   // compression of the record
+// uint16_t num_pages              // pages the record is split into
+// uint32_t offset                 // from the start of the file to the compressed record
+// uint32_t compressed_length      // length of the compressed record
+// uint32_t raw_length             // length of the record when it is decompressed
+// -- each record is then compressed on its own.  A record of more than one
+// -- page starts with uint32_t compressed_length[num_pages] and each page of
+// -- 1 << page_shift bytes, the last one shorter, is compressed on its own
+// the sections follow the header, or the directory if there is one.  They
+// are never compressed
+// char tag[4]
+// uint32_t length                 // of the data, the data is padded to 4 bytes
+// uint8_t data[length]
+// -- ACCL, glyph lookup.  The char maps are the same in every record so a
+// -- character's glyph offset is at the same place in all of them
+// uint32_t num_index              // pages of 256 characters up to the last character
+// uint16_t page_index[num_index]  // page of the entries, 0xFFFF if there are none
+// uint16_t entries[][256]         // position of the character's glyphs_offset
+                                    // from the start of a record, 0 if the font
+                                    // does not have it. uint32_t in v2
+// -- TAPE, rolling digit strips.  A strip is the digits 0 to 9 and 0 again
+// -- stacked in cells of digit_height rows, so any scroll position of a
+// -- digit drum is a window of whole rows.  Digit d starts at row
+// -- d * digit_height
+// uint8_t num_tapes
+// uint8_t reserved[3]
+// -- then num_tapes of --
+// uint8_t size                    // pixel size of the record the strip is drawn from
+// uint8_t bits_per_pixel          // 0 (1 bit), 2, 4 or 8
+// uint8_t width                   // pixels across the strip, the widest digit
+// uint8_t digit_height            // rows of each digit, the vertical_height
+// uint8_t baseline                // rows from the top of a cell to the baseline
+// uint8_t reserved[3]
+// uint32_t offset                 // from the start of the section data to the bitmap
+// -- each bitmap is
+// uint8_t bitmap[stride * digit_height * 11] // rows as in a glyph
+// -- MTRX, glyph metrics away from the bitmaps.  The characters the char
+// -- maps span, holes included, are slots numbered in map order.  Text is
+// -- measured from the advance array without touching the glyphs
+// uint8_t num_metrics             // one for each record
+// uint8_t reserved[3]
+// uint32_t num_slots
+// -- then num_metrics of --
+// uint8_t size                    // pixel size of the record
+// uint8_t reserved[3]
+// uint32_t offset                 // from the start of the section data to the arrays
+// -- the arrays of each record are
+// uint8_t advance[num_slots]      // glyph_advance, 0 for a hole
+// uint8_t box[num_slots][4]       // glyph_baseline, glyph_offset, width, height,
+                                    // from a 4 byte boundary, signed as in the record
+// -- ROTN, rotated glyph sets.  Each set is a record with
+// -- FONT_RECORD_FLAG_ROTATED, angle i of a size is start_angle +
+// -- i * step_angle degrees counterclockwise
+// uint16_t start_angle
+// uint16_t step_angle
+// uint8_t num_angles
+// uint8_t num_sizes
+// uint8_t reserved[2]
+// -- then num_sizes of --
+// uint8_t size                    // pixel size of the upright record
+// uint8_t records[num_angles]     // record of each angle, in file order
+// -- the records follow the sections
+// the following record is repeated for num_fonts
+// -- if the file type is CFNT then all that remains is compressed ---
+// uint16_t record_size;            // length of this font record, uint32_t in v2
+// uint8_t size;                   // height of the font this bitmap renders
+// uint8_t vertical_height;        // height including ascender/descender
+// uint8_t baseline;               // where logical 0 is for the font outline.
+// uint8_t num_maps                // number of character maps
+// uint8_t bits_per_pixel          // coverage depth of the glyphs, 0 (1 bit), 2, 4 or 8
+// uint8_t flags                   // FONT_RECORD_FLAG_
+// the character maps then continue for the num_maps
+// uint8_t start_char              // first character in the character map
+// uint8_t last_char               // last character in the character map
+// -- FONT_RECORD_FLAG_WIDE_MAPS --
+// uint32_t start_char             // first code point in the character map
+// uint32_t last_char              // last code point in the character map
+// --
+// uint16_t glyphs_offset[]         // offset to the glyph records (offset from start of the block)
+                                    // uint32_t in v2
+// each glyph is indexed based on this number
+// The glyphs then follow in the following format
+// uint8_t glyph_advance           // horizontal advance for the glyph
+// uint8_t glyph_baseline          // baseline of the bitmap, is aligned to the baseline when rendered
+// uint8_t glyph_offset;           // offset to col 0 of the glyph
+// -- FONT_RECORD_FLAG_ROTATED, glyph_baseline and glyph_offset are int8_t
+// -- and place the bitmap at (pen x + glyph_offset, pen y - glyph_baseline).
+// -- glyph_advance is the upright advance, taken along the angle
+// uint8_t width                   // width of the actual glyph
+// uint8_t height                  // height of the glyph
+// -- FONT_RECORD_FLAG_ENCODED_GLYPHS --
+// uint8_t encoding                // FONT_GLYPH_RAW or FONT_GLYPH_RUNS
+// --
+// uint8_t bitmap[stride * height]  // alpha values of the bitmap, rows of
+                                    // stride = (width * bits_per_pixel + 7) / 8
+                                    // bytes, the leftmost pixel in the msb
+// -- FONT_GLYPH_RUNS replaces the bitmap with the ink of each row --
+// uint8_t num_runs                // repeated for each row, FONT_RUNS_REPEAT if
+                                    // the row is the same as the row above
+// uint8_t start, length           // repeated for num_runs, the run's columns
+// ----- End of deflated record
+//
+// All multi-byte values are stored most significant byte first.
+//
+// The char map table and each glyph record are padded to 16 bytes.  A font
+// can be built with 1, 2 or 4 byte alignment instead, the offsets are all a
+// reader needs so the alignment is not recorded.
+//
+// v2 only widens the lengths and offsets so fonts can be larger than 64k.
+// The generator writes v1 whenever the font fits.
+//
+// A char map can span characters the font does not have, their
+// glyphs_offset is 0.
+//
+// Characters are Unicode code points.  A font that only has code points
+// below 256 keeps the one byte char map characters, any other font sets
+// FONT_RECORD_FLAG_WIDE_MAPS in every record.
+//
+// The upright records come first and a rotated record has the same char
+// maps as the upright records, only its glyphs are turned.
+
+#define FONT_MAGIC              "FONT"
+#define CFNT_MAGIC              "CFNT"
+
+#define FONT_NAME_MAX           16      // REG_NAME_MAX
+#define FONT_HEADER_SIZE        32      // magic + name + length + num_fonts + reserved
+#define FONT_MAX_FILE_LENGTH    65535
+
+// header fields
+#define FONT_NAME_OFFSET        4
+#define FONT_LENGTH_OFFSET      20      // uint16_t file_length
+#define FONT_NUM_FONTS_OFFSET   22
+#define FONT_VERSION_OFFSET     23
+#define FONT_LENGTH32_OFFSET    24      // uint32_t file_length of v2
+#define FONT_CODEC_OFFSET       28      // header byte holding the codec
+#define FONT_FLAGS_OFFSET       29
+#define FONT_PAGE_SHIFT_OFFSET  30
+#define FONT_NUM_SECTIONS_OFFSET 31
+
+#define FONT_FLAG_DIRECTORY     0x01    // records are compressed on their own
+
+#define FONT_DIRECTORY_ENTRY_SIZE 16
+#define FONT_MIN_PAGE_SHIFT     8
+#define FONT_MAX_PAGE_SHIFT     16
+
+#define FONT_SECTION_HEADER_SIZE 8      // tag + length
+#define FONT_ACCEL_TAG          "ACCL"
+#define FONT_ACCEL_NO_PAGE      0xFFFF
+#define FONT_TAPE_TAG           "TAPE"
+#define FONT_TAPE_HEADER_SIZE   4       // num_tapes + reserved
+#define FONT_TAPE_ENTRY_SIZE    12
+#define FONT_TAPE_DIGITS        11      // 0 to 9 and 0 again
+#define FONT_METRICS_TAG        "MTRX"
+#define FONT_METRICS_HEADER_SIZE 8      // num_metrics + reserved + num_slots
+#define FONT_METRICS_ENTRY_SIZE 8
+#define FONT_METRICS_BOX_SIZE   4       // baseline, offset, width, height
+#define FONT_ROTATION_TAG       "ROTN"
+#define FONT_ROTATION_HEADER_SIZE 8     // angles + num_angles + num_sizes + reserved
+
+// CFNT codecs, compression of everything after the header
+#define FONT_CODEC_XPRESS_HUFF  0       // Windows compression API
+#define FONT_CODEC_LZ4          1       // LZ4 block format
+#define FONT_CODEC_DEFLATE      2       // zlib stream (RFC 1950)
+#define FONT_CODEC_LZSS         3       // 4k window, 2 byte matches
+#define FONT_CODEC_NONE         4       // stored
+#define FONT_NUM_CODECS         5
+#define FONT_CODEC_PER_RECORD   0xFF    // header codec when directory records differ
+
+#define FONT_VERSION_1          1       // 16 bit lengths and offsets, written as 0
+#define FONT_VERSION_2          2       // 32 bit lengths and offsets
+
+#define FONT_RECORD_HEADER_SIZE 8       // record_size + size .. reserved
+
+// record header fields, from the end of the record_size
+#define FONT_RECORD_PIXEL_SIZE  0
+#define FONT_RECORD_HEIGHT      1
+#define FONT_RECORD_BASELINE    2
+#define FONT_RECORD_NUM_MAPS    3
+#define FONT_RECORD_BPP         4
+#define FONT_RECORD_FLAGS       5
+
+#define FONT_RECORD_FLAG_WIDE_MAPS 0x01 // char maps hold 32 bit code points
+#define FONT_RECORD_FLAG_ENCODED_GLYPHS 0x02 // glyphs have an encoding byte
+#define FONT_RECORD_FLAG_ROTATED 0x04   // glyphs are turned, placement is signed
+
+// glyph encodings
+#define FONT_GLYPH_RAW          0       // the bitmap
+#define FONT_GLYPH_RUNS         1       // 1 bit per pixel runs of ink, drawn as lines
+#define FONT_RUNS_REPEAT        0x80    // num_runs of a row that repeats the row above
+
+#define FONT_CHARMAP_HEADER_SIZE 2      // start_char + last_char
+#define FONT_WIDE_CHARMAP_HEADER_SIZE 8 // start_char + last_char of wide maps
+#define FONT_MAX_NARROW_CHAR    0xFF    // last character of a narrow char map
+#define FONT_MAX_CODE_POINT     0x10FFFF
+#define FONT_MAX_MAPS           255     // num_maps is a byte
+#define FONT_GLYPH_HEADER_SIZE  5       // advance .. height
+#define FONT_ALIGNMENT          16      // char maps and glyphs are rounded to this by default
+#define FONT_MAX_BPP            8       // deepest glyph coverage
+
+// variable length..
+struct glyph_t {
+  uint8_t advance;           // advance for the glyph
+  uint8_t baseline;          // baseline of the bitmap.
+  uint8_t offset;            // offset to first column of bitmap
+  uint8_t width;             // width of the bitmap
+  uint8_t height;            // height of the bitmap
+  uint8_t pixels[];
+  };
+
+// read a big endian value of numBytes
+inline uint32_t FontGetBigEndian(const uint8_t *p, uint32_t numBytes)
+  {
+  uint32_t value = 0;
+  for(uint32_t i = 0; i < numBytes; i++)
+    value = (value << 8) | p[i];
+
+  return value;
+  }
+
+// round a length up to the font alignment
+inline uint32_t FontAlign(uint32_t len, uint32_t alignment = FONT_ALIGNMENT)
+  {
+  return ((len - 1) | (alignment - 1)) + 1;
+  }
+
+// true if records can be padded to the alignment
+inline bool FontValidAlignment(int alignment)
+  {
+  return alignment == 1 || alignment == 2 || alignment == 4 || alignment == 16;
+  }
+
+// bytes in a record_size or glyphs_offset
+inline uint32_t FontOffsetSize(int version)
+  {
+  return version >= FONT_VERSION_2 ? 4 : 2;
+  }
+
+// bytes before the character offsets of a char map
+inline uint32_t FontCharMapHeaderSize(bool wide)
+  {
+  return wide ? FONT_WIDE_CHARMAP_HEADER_SIZE : FONT_CHARMAP_HEADER_SIZE;
+  }
+
+// bytes before the first char map of a record
+inline uint32_t FontRecordHeaderSize(int version)
+  {
+  return FONT_RECORD_HEADER_SIZE - 2 + FontOffsetSize(version);
+  }
+
+// true if glyphs can be stored with the coverage depth
+inline bool FontValidBpp(int bpp)
+  {
+  return bpp == 1 || bpp == 2 || bpp == 4 || bpp == 8;
+  }
+
+// bytes per row of a bitmap, 1 bit per pixel unless given
+inline uint16_t FontStride(uint16_t width, int bpp = 1)
+  {
+  return (uint16_t)((width * bpp + 7) >> 3);
+  }
+
+#endif // !defined(FONTGEN_FONTFORMAT_H)
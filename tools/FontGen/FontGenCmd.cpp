@@ -0,0 +1,827 @@
+// FontGenCmd.cpp : command line front end for the font generator
+//
+// Builds a font file without the FontGen dialog so fonts can be
+// regenerated from a script.
+//
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <chrono>
+#include <map>
+#include <memory>
+
+#include "FontBuilder.h"
+#include "FontCodec.h"
+#include "FontRasterizer.h"
+
+static void Usage()
+  {
+  fprintf(stderr,
+    "usage: FontGenCmd [options] -f <face> -s <sizes> -o <output>\n"
+    "       FontGenCmd [options] -m <manifest>\n"
+    "  -f, --face <face>       installed font face or TTF/OTF file to render\n"
+    "  -s, --sizes <list>      comma separated pixel sizes, e.g. 9,12,15,18\n"
+    "  -o, --output <file>     output file\n"
+    "  -n, --name <name>       name embedded in the font (16 chars, default face)\n"
+    "  -c, --charset <chars>   UTF-8 characters to generate.  U+XXXX with four hex\n"
+    "                          digits or U+{X} with one to six adds a code point,\n"
+    "                          U+XXXX-U+YYYY a range.  Hex letters can follow an\n"
+    "                          escape, U+00B0ABC is the degree sign and ABC\n"
+    "                          (default printable ASCII)\n"
+    "  -t, --type <type>       output type: c, cstring, base64 or binary (default c).\n"
+    "                          cstring is a C string literal, under half the size\n"
+    "  -z, --codec <codec>     base64/binary compression: xpress, lz4, deflate, lzss,\n"
+    "                          none, smallest or fastest (default xpress on Windows,\n"
+    "                          lz4 elsewhere)\n"
+    "  -w, --weight <weight>   font weight, 0 = default, 400 = normal, 700 = bold\n"
+    "  -i, --italic            render an italic face\n"
+    "  -u, --underline         render an underlined face\n"
+    "  -b, --bpp <bits>        antialiased coverage bits per pixel, 1, 2, 4 or 8 (default 1)\n"
+    "      --accel             add a glyph lookup table to the font\n"
+    "      --maps <goal>       char map partition: size or lookup (default size)\n"
+    "      --directory         compress each record on its own behind a directory\n"
+    "      --page-size <n>     split directory records into pages of n bytes\n"
+    "  -r, --rasterizer <r>    gdi or freetype (default freetype for font files)\n"
+    "  -j, --threads <n>       render threads (default one per processor)\n"
+    "      --metrics           add glyph metrics arrays for fast text measuring\n"
+    "      --tape <sizes>      add rolling digit strips of these pixel sizes\n"
+    "      --rotate <angles>   add glyph sets turned start:step[:end] degrees\n"
+    "                          counterclockwise, the end defaults to a full turn\n"
+    "      --rle               store 1 bit glyphs as row runs when that is smaller\n"
+    "      --no-share          store every glyph, even identical ones\n"
+    "      --cache <dir>       keep rendered glyphs in dir and only render new ones\n"
+    "  -a, --align <bytes>     glyph alignment, 1, 2, 4 or 16 (default 16)\n"
+    "      --format <v>        file format, 1 or 2 (default 1 unless the font needs 2)\n"
+    "  -m, --manifest <file>   build every output in the file, one line of options\n"
+    "                          each.  The options given here apply to all of them\n"
+    "      --verify            read each font back and check every glyph against what\n"
+    "                          was built, fail if one differs\n"
+    "      --bench <runs>      build the face with each of a fixed set of character\n"
+    "                          sets and pixel sizes runs times and report the time\n"
+    "                          of each stage and the mean wall time of a build.\n"
+    "                          -s and -c are not used\n"
+    "      --report <file>     write the sizes, bytes and stage times of the font as\n"
+    "                          JSON.  Outputs of a manifest with the same report\n"
+    "                          file are listed together\n"
+    "  -v, --verbose           report what went into the font\n");
+  }
+
+// the sizes replace any given before, so the last -s of a manifest
+// line wins over the command line
+static bool ParseSizes(const char *arg, std::vector<int> &sizes)
+  {
+  sizes.clear();
+  while(*arg != 0)
+    {
+    char *end;
+    long size = strtol(arg, &end, 10);
+    if(end == arg || size < 1 || size > 255)
+      return false;
+
+    sizes.push_back((int) size);
+
+    arg = end;
+    if(*arg == ',')
+      arg++;
+    else if(*arg != 0)
+      return false;
+    }
+
+  return !sizes.empty();
+  }
+
+static bool ParseRasterizer(const char *arg, int &rasterizer)
+  {
+  if(strcmp(arg, "gdi") == 0)
+    rasterizer = RASTERIZER_GDI;
+  else if(strcmp(arg, "freetype") == 0)
+    rasterizer = RASTERIZER_FREETYPE;
+  else
+    return false;
+
+  return true;
+  }
+
+// default font name, the face or the file name without path and extension
+static std::string DefaultFontName(const std::string &face)
+  {
+  std::string name = face;
+
+  size_t sep = name.find_last_of("/\\");
+  if(sep != std::string::npos)
+    name = name.substr(sep + 1);
+
+  size_t ext = name.rfind('.');
+  if(ext != std::string::npos && ext > 0)
+    name = name.substr(0, ext);
+
+  return name.substr(0, FONT_NAME_MAX);
+  }
+
+static bool ParseCodec(const char *arg, int &codec)
+  {
+  if(strcmp(arg, "smallest") == 0)
+    codec = CODEC_SMALLEST;
+  else if(strcmp(arg, "fastest") == 0)
+    codec = CODEC_FASTEST;
+  else
+    codec = FontCodecFromName(arg);
+
+  return codec != -1;
+  }
+
+static bool ParseOutputType(const char *arg, int &outputType)
+  {
+  if(strcmp(arg, "c") == 0)
+    outputType = OUTPUT_C;
+  else if(strcmp(arg, "cstring") == 0)
+    outputType = OUTPUT_C_STRING;
+  else if(strcmp(arg, "base64") == 0)
+    outputType = OUTPUT_BASE64;
+  else if(strcmp(arg, "binary") == 0)
+    outputType = OUTPUT_BINARY;
+  else
+    return false;
+
+  return true;
+  }
+
+// start:step[:end] of the rotated glyph sets
+static bool ParseRotation(const char *arg, FontParams &params)
+  {
+  char *end;
+  params.startAngle = (int) strtol(arg, &end, 10);
+  if(end == arg || *end != ':')
+    return false;
+
+  arg = end + 1;
+  params.stepAngle = (int) strtol(arg, &end, 10);
+  if(end == arg || params.stepAngle < 1 || params.stepAngle > 359)
+    return false;
+
+  params.endAngle = params.startAngle + 360;
+  if(*end == ':')
+    {
+    arg = end + 1;
+    params.endAngle = (int) strtol(arg, &end, 10);
+    if(end == arg)
+      return false;
+    }
+
+  return *end == 0;
+  }
+
+static void PrintReport(const std::string &outputName, const FontBuilder &builder)
+  {
+  const FontReport &report = builder.Report();
+
+  printf("%s: %u bytes, format v%d\n", outputName.c_str(), (unsigned) builder.FontFile().size(), report.version);
+  printf("  glyphs         %u\n", report.glyphs);
+  if(report.cachedGlyphs > 0)
+    printf("  cached glyphs  %u\n", report.cachedGlyphs);
+  printf("  shared glyphs  %u, %u bytes saved\n", report.sharedGlyphs, report.sharedBytes);
+  if(report.runGlyphs > 0)
+    printf("  run glyphs     %u\n", report.runGlyphs);
+  printf("  char maps      %u, %u null offsets\n", report.charMaps, report.mapHoles);
+
+  if(report.codec == FONT_CODEC_PER_RECORD)
+    printf("  codec          per record, %u of %u bytes in %u pages\n", report.compressedBytes, report.recordBytes, report.pages);
+  else if(report.codec >= 0)
+    printf("  codec          %s, %u of %u bytes in %u pages\n", FontCodecName(report.codec), report.compressedBytes,
+      report.recordBytes, report.pages);
+
+  if(report.sectionBytes > 0)
+    printf("  sections       %u bytes\n", report.sectionBytes);
+  if(report.rotatedRecords > 0)
+    printf("  rotated sets   %u\n", report.rotatedRecords);
+
+  printf("  padding        %u bytes, %.1f%% of the records\n", report.paddingBytes,
+    report.recordBytes > 0 ? report.paddingBytes * 100.0 / report.recordBytes : 0.0);
+  }
+
+// write a JSON report of the fonts, each formatted by FormatJsonReport
+static bool WriteReportFile(const std::string &fileName, const std::string &fonts)
+  {
+  FILE *file = fopen(fileName.c_str(), "w");
+  if(file == NULL)
+    {
+    fprintf(stderr, "cannot create the report %s\n", fileName.c_str());
+    return false;
+    }
+
+  fprintf(file, "{\n  \"fonts\": [\n  %s\n  ]\n}\n", fonts.c_str());
+  if(fclose(file) != 0)
+    {
+    fprintf(stderr, "cannot write the report %s\n", fileName.c_str());
+    return false;
+    }
+
+  return true;
+  }
+
+// the options of one output
+struct FontOptions
+  {
+  FontParams params;
+  std::string outputName;
+  std::string manifest;       // build the outputs listed in this file instead
+  std::string reportName;     // JSON report file, none if empty
+  bool verbose;
+  bool verify;                // read the font back after building it
+  int benchRuns;              // times to build each font of the --bench matrix, 0 for none
+
+  FontOptions()
+    {
+    verbose = false;
+    verify = false;
+    benchRuns = 0;
+    }
+  };
+
+// true if argv[i] is the short or long form of an option
+static bool IsOption(const char *arg, const char *shortName, const char *longName)
+  {
+  return strcmp(arg, shortName) == 0 || strcmp(arg, longName) == 0;
+  }
+
+// parse options from argv[first], returns the exit code if the program
+// should stop or -1 if it should go on.  A manifest line has to describe
+// an output so it cannot ask for the usage
+static int ParseOptions(int argc, char *argv[], int first, FontOptions &options, bool manifestLine = false)
+  {
+  FontParams &params = options.params;
+
+  for(int i = first; i < argc; i++)
+    {
+    const char *arg = argv[i];
+
+    if(IsOption(arg, "-i", "--italic"))
+      {
+      params.italic = true;
+      continue;
+      }
+
+    if(IsOption(arg, "-u", "--underline"))
+      {
+      params.underline = true;
+      continue;
+      }
+
+    if(IsOption(arg, "-v", "--verbose"))
+      {
+      options.verbose = true;
+      continue;
+      }
+
+    if(strcmp(arg, "--verify") == 0)
+      {
+      options.verify = true;
+      continue;
+      }
+
+    if(strcmp(arg, "--accel") == 0)
+      {
+      params.accelTable = true;
+      continue;
+      }
+
+    if(strcmp(arg, "--directory") == 0)
+      {
+      params.recordDirectory = true;
+      continue;
+      }
+
+    if(strcmp(arg, "--metrics") == 0)
+      {
+      params.metricsTable = true;
+      continue;
+      }
+
+    if(strcmp(arg, "--rle") == 0)
+      {
+      params.runLengthGlyphs = true;
+      continue;
+      }
+
+    if(strcmp(arg, "--no-share") == 0)
+      {
+      params.shareGlyphs = false;
+      continue;
+      }
+
+    if(IsOption(arg, "-h", "--help"))
+      {
+      if(manifestLine)
+        {
+        fprintf(stderr, "%s cannot be used in a manifest\n", arg);
+        return 1;
+        }
+
+      Usage();
+      return 0;
+      }
+
+    // all remaining options take a value
+    if(i + 1 >= argc)
+      {
+      fprintf(stderr, "missing value for %s\n", arg);
+      Usage();
+      return 1;
+      }
+
+    const char *value = argv[++i];
+
+    if(IsOption(arg, "-f", "--face"))
+      params.fontFace = value;
+    else if(IsOption(arg, "-n", "--name"))
+      params.fontName = value;
+    else if(IsOption(arg, "-c", "--charset"))
+      params.charSet = value;
+    else if(IsOption(arg, "-o", "--output"))
+      options.outputName = value;
+    else if(IsOption(arg, "-w", "--weight"))
+      params.fontWeight = atol(value);
+    else if(IsOption(arg, "-b", "--bpp"))
+      {
+      params.bitsPerPixel = atoi(value);
+      if(!FontValidBpp(params.bitsPerPixel))
+        {
+        fprintf(stderr, "invalid bits per pixel '%s'\n", value);
+        return 1;
+        }
+      }
+    else if(IsOption(arg, "-a", "--align"))
+      {
+      params.alignment = atoi(value);
+      if(!FontValidAlignment(params.alignment))
+        {
+        fprintf(stderr, "invalid alignment '%s'\n", value);
+        return 1;
+        }
+      }
+    else if(IsOption(arg, "-m", "--manifest"))
+      options.manifest = value;
+    else if(strcmp(arg, "--report") == 0)
+      options.reportName = value;
+    else if(strcmp(arg, "--bench") == 0)
+      {
+      options.benchRuns = atoi(value);
+      if(options.benchRuns < 1)
+        {
+        fprintf(stderr, "invalid run count '%s'\n", value);
+        return 1;
+        }
+      }
+    else if(strcmp(arg, "--cache") == 0)
+      params.cacheDir = value;
+    else if(strcmp(arg, "--page-size") == 0)
+      {
+      params.recordDirectory = true;
+      params.pageSize = (uint32_t) strtoul(value, NULL, 10);
+      }
+    else if(strcmp(arg, "--maps") == 0)
+      {
+      if(strcmp(value, "size") == 0)
+        params.mapPartition = MAPS_SIZE;
+      else if(strcmp(value, "lookup") == 0)
+        params.mapPartition = MAPS_LOOKUP;
+      else
+        {
+        fprintf(stderr, "unknown char map partition '%s'\n", value);
+        return 1;
+        }
+      }
+    else if(strcmp(arg, "--format") == 0)
+      {
+      params.formatVersion = atoi(value);
+      if(params.formatVersion != FONT_VERSION_1 && params.formatVersion != FONT_VERSION_2)
+        {
+        fprintf(stderr, "unknown format '%s'\n", value);
+        return 1;
+        }
+      }
+    else if(IsOption(arg, "-j", "--threads"))
+      {
+      params.threads = atoi(value);
+      if(params.threads < 1)
+        {
+        fprintf(stderr, "invalid thread count '%s'\n", value);
+        return 1;
+        }
+      }
+    else if(IsOption(arg, "-s", "--sizes"))
+      {
+      if(!ParseSizes(value, params.sizes))
+        {
+        fprintf(stderr, "invalid pixel sizes '%s'\n", value);
+        return 1;
+        }
+      }
+    else if(strcmp(arg, "--tape") == 0)
+      {
+      if(!ParseSizes(value, params.tapeSizes))
+        {
+        fprintf(stderr, "invalid digit tape sizes '%s'\n", value);
+        return 1;
+        }
+      }
+    else if(strcmp(arg, "--rotate") == 0)
+      {
+      if(!ParseRotation(value, params))
+        {
+        fprintf(stderr, "invalid rotation '%s'\n", value);
+        return 1;
+        }
+      }
+    else if(IsOption(arg, "-t", "--type"))
+      {
+      if(!ParseOutputType(value, params.outputType))
+        {
+        fprintf(stderr, "unknown output type '%s'\n", value);
+        return 1;
+        }
+      }
+    else if(IsOption(arg, "-z", "--codec"))
+      {
+      if(!ParseCodec(value, params.codec))
+        {
+        fprintf(stderr, "unknown codec '%s'\n", value);
+        return 1;
+        }
+      }
+    else if(IsOption(arg, "-r", "--rasterizer"))
+      {
+      if(!ParseRasterizer(value, params.rasterizer))
+        {
+        fprintf(stderr, "unknown rasterizer '%s'\n", value);
+        return 1;
+        }
+      }
+    else
+      {
+      fprintf(stderr, "unknown option %s\n", arg);
+      Usage();
+      return 1;
+      }
+    }
+
+  return -1;
+  }
+
+// check the options of one output and fill in the defaults, returns the
+// exit code if it cannot be built or -1
+static int CheckOutput(FontOptions &options)
+  {
+  FontParams &params = options.params;
+
+  if(params.fontFace.empty() || params.sizes.empty() || options.outputName.empty())
+    {
+    Usage();
+    return 1;
+    }
+
+  if(params.fontName.empty())
+    params.fontName = DefaultFontName(params.fontFace);
+
+  if(params.fontName.length() > FONT_NAME_MAX)
+    {
+    fprintf(stderr, "font name '%s' is longer than %d characters\n", params.fontName.c_str(), FONT_NAME_MAX);
+    return 1;
+    }
+
+  return -1;
+  }
+
+// split a manifest into the arguments of each output.  Arguments are
+// separated by white space and can be quoted with ' or ", a \ at the end
+// of a line continues it and a # starts a comment
+static bool SplitManifest(const std::string &text, std::vector<std::vector<std::string> > &lines,
+  std::vector<int> &lineNumbers)
+  {
+  std::vector<std::string> args;
+  std::string arg;
+  bool inArg = false;
+  int lineNumber = 1;
+  int firstLine = 1;
+
+  for(size_t i = 0; i <= text.length(); i++)
+    {
+    char c = i < text.length() ? text[i] : '\n';
+
+    if(c == '\\' && i + 1 < text.length() && (text[i + 1] == '\n' || text[i + 1] == '\r'))
+      {
+      // a continued line
+      while(i + 1 < text.length() && text[i + 1] != '\n')
+        i++;
+      i++;
+      lineNumber++;
+      c = ' ';
+      }
+    else if(c == '#' && !inArg)
+      {
+      while(i + 1 < text.length() && text[i + 1] != '\n')
+        i++;
+      continue;
+      }
+    else if(c == '\'' || c == '"')
+      {
+      char quote = c;
+      inArg = true;
+      for(i++; i < text.length() && text[i] != quote; i++)
+        {
+        if(text[i] == '\n')
+          return false;
+
+        if(quote == '"' && text[i] == '\\' && i + 1 < text.length() && (text[i + 1] == '"' || text[i + 1] == '\\'))
+          i++;
+
+        arg += text[i];
+        }
+
+      if(i >= text.length())
+        return false;
+
+      continue;
+      }
+
+    if(c == ' ' || c == '\t' || c == '\r' || c == '\n')
+      {
+      if(inArg)
+        {
+        if(args.empty())
+          firstLine = lineNumber;
+
+        args.push_back(arg);
+        arg.clear();
+        inArg = false;
+        }
+
+      if(c == '\n')
+        {
+        if(!args.empty())
+          {
+          lines.push_back(args);
+          lineNumbers.push_back(firstLine);
+          args.clear();
+          }
+
+        lineNumber++;
+        }
+
+      continue;
+      }
+
+    arg += c;
+    inArg = true;
+    }
+
+  return true;
+  }
+
+// build every output of a manifest.  The options on the command line
+// apply to each of them and -j sets the threads they all share
+static int BuildManifest(const FontOptions &defaults)
+  {
+  FILE *file = fopen(defaults.manifest.c_str(), "rb");
+  if(file == NULL)
+    {
+    fprintf(stderr, "cannot open the manifest %s\n", defaults.manifest.c_str());
+    return 1;
+    }
+
+  std::string text;
+  char buffer[4096];
+  size_t len;
+  while((len = fread(buffer, 1, sizeof(buffer), file)) > 0)
+    text.append(buffer, len);
+
+  fclose(file);
+
+  std::vector<std::vector<std::string> > lines;
+  std::vector<int> lineNumbers;
+  if(!SplitManifest(text, lines, lineNumbers))
+    {
+    fprintf(stderr, "%s: a quote is not closed\n", defaults.manifest.c_str());
+    return 1;
+    }
+
+  std::vector<FontOptions> outputs(lines.size(), defaults);
+  for(size_t n = 0; n < lines.size(); n++)
+    {
+    std::vector<char *> argv;
+    for(size_t a = 0; a < lines[n].size(); a++)
+      argv.push_back(&lines[n][a][0]);
+
+    outputs[n].manifest.clear();
+
+    int exitCode = ParseOptions((int) argv.size(), &argv[0], 0, outputs[n], true);
+    if(exitCode < 0 && !outputs[n].manifest.empty())
+      {
+      fprintf(stderr, "a manifest cannot name another manifest\n");
+      exitCode = 1;
+      }
+
+    if(exitCode < 0)
+      exitCode = CheckOutput(outputs[n]);
+
+    if(exitCode >= 0)
+      {
+      fprintf(stderr, "%s:%d: the output is not valid\n", defaults.manifest.c_str(), lineNumbers[n]);
+      return exitCode;
+      }
+    }
+
+  std::vector<std::unique_ptr<FontBuilder> > builders;
+  std::vector<FontBuilder *> batch;
+  for(size_t n = 0; n < outputs.size(); n++)
+    {
+    builders.push_back(std::unique_ptr<FontBuilder>(new FontBuilder(outputs[n].params)));
+    batch.push_back(builders.back().get());
+    }
+
+  // the errors are reported for each output
+  FontBuilder::GenerateFontFiles(batch, defaults.params.threads);
+
+  int exitCode = 0;
+  std::map<std::string, std::string> reports;
+  for(size_t n = 0; n < outputs.size(); n++)
+    {
+    const std::string &outputName = outputs[n].outputName;
+    if(!batch[n]->Error().empty() || (outputs[n].verify && !batch[n]->VerifyFontFile()) ||
+       !batch[n]->WriteOutputFile(outputName))
+      {
+      fprintf(stderr, "%s: %s\n", outputName.c_str(), batch[n]->Error().c_str());
+      exitCode = 1;
+      continue;
+      }
+
+    if(!batch[n]->Warning().empty())
+      fprintf(stderr, "%s: warning: %s\n", outputName.c_str(), batch[n]->Warning().c_str());
+
+    if(outputs[n].verbose)
+      PrintReport(outputName, *batch[n]);
+
+    if(!outputs[n].reportName.empty())
+      {
+      std::string &fonts = reports[outputs[n].reportName];
+      if(!fonts.empty())
+        fonts += ",\n  ";
+      batch[n]->FormatJsonReport(outputName, fonts);
+      }
+    }
+
+  std::map<std::string, std::string>::const_iterator it;
+  for(it = reports.begin(); it != reports.end(); ++it)
+    if(!WriteReportFile(it->first, it->second))
+      exitCode = 1;
+
+  return exitCode;
+  }
+
+// the character sets and pixel sizes --bench builds, from a small font
+// for a display to a large one with thousands of characters
+static const char *benchCharSets[][2] =
+  {
+  { "ascii", NULL },
+  { "latin-1", "U+0020-U+007EU+00A0-U+00FF" },
+  { "U+0020-U+07FF", "U+0020-U+07FF" },
+  };
+
+static const char *benchSizes[] = { "9,12,15", "24,32", "48,64" };
+
+// stages of the build in the order of FontReport
+#define BENCH_STAGES 5
+
+// build the face with each character set and sizes of the matrix
+// options.benchRuns times and print the fastest time of each stage and
+// the mean wall time of building and writing it.  The render and pack
+// stages are summed over the threads so they can add up to more than
+// the wall time.  The other options apply to every font
+static int RunBench(const FontOptions &options)
+  {
+  if(options.params.fontFace.empty())
+    {
+    Usage();
+    return 1;
+    }
+
+  std::string outputName = options.outputName.empty() ? "FontGenCmd.bench" : options.outputName;
+
+  printf("%-14s %-8s %9s %9s %9s %9s %9s %10s %9s\n", "chars", "sizes", "render", "pack", "assemble", "compress",
+    "write", "mean ms", "bytes");
+
+  for(size_t c = 0; c < sizeof(benchCharSets) / sizeof(benchCharSets[0]); c++)
+    for(size_t z = 0; z < sizeof(benchSizes) / sizeof(benchSizes[0]); z++)
+      {
+      FontOptions bench = options;
+      FontParams &params = bench.params;
+      params.charSet = benchCharSets[c][1] != NULL ? benchCharSets[c][1] : FontParams::DefaultCharSet();
+      ParseSizes(benchSizes[z], params.sizes);
+      if(params.fontName.empty())
+        params.fontName = DefaultFontName(params.fontFace);
+
+      FontBuilder builder(params);
+      double fastest[BENCH_STAGES];
+      double total = 0;
+      for(int run = 0; run < options.benchRuns; run++)
+        {
+        // the verify is not part of the build it times
+        std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+        bool built = builder.GenerateFontFile();
+        std::chrono::steady_clock::duration elapsed = std::chrono::steady_clock::now() - start;
+
+        built = built && (!options.verify || builder.VerifyFontFile());
+
+        start = std::chrono::steady_clock::now();
+        built = built && builder.WriteOutputFile(outputName);
+        elapsed += std::chrono::steady_clock::now() - start;
+
+        if(!built)
+          {
+          fprintf(stderr, "%s %s: %s\n", benchCharSets[c][0], benchSizes[z], builder.Error().c_str());
+          return 1;
+          }
+
+        total += std::chrono::duration<double>(elapsed).count();
+
+        const FontReport &report = builder.Report();
+        double seconds[BENCH_STAGES] = { report.renderSeconds, report.packSeconds, report.assembleSeconds,
+          report.compressSeconds, report.writeSeconds };
+
+        for(int n = 0; n < BENCH_STAGES; n++)
+          {
+          if(run == 0 || seconds[n] < fastest[n])
+            fastest[n] = seconds[n];
+          }
+        }
+
+      printf("%-14s %-8s %9.2f %9.2f %9.2f %9.2f %9.2f %10.2f %9u\n", benchCharSets[c][0], benchSizes[z],
+        fastest[0] * 1000, fastest[1] * 1000, fastest[2] * 1000, fastest[3] * 1000, fastest[4] * 1000,
+        total * 1000 / options.benchRuns, (unsigned) builder.FontFile().size());
+      }
+
+  if(options.outputName.empty())
+    remove(outputName.c_str());
+
+  return 0;
+  }
+
+int main(int argc, char *argv[])
+  {
+  FontOptions options;
+
+  int exitCode = ParseOptions(argc, argv, 1, options);
+  if(exitCode >= 0)
+    return exitCode;
+
+  if(!options.manifest.empty())
+    {
+    if(!options.outputName.empty())
+      {
+      fprintf(stderr, "the outputs of a manifest are named in the manifest\n");
+      return 1;
+      }
+
+    if(options.benchRuns > 0)
+      {
+      fprintf(stderr, "--bench times its own fonts, not a manifest\n");
+      return 1;
+      }
+
+    return BuildManifest(options);
+    }
+
+  if(options.benchRuns > 0)
+    return RunBench(options);
+
+  exitCode = CheckOutput(options);
+  if(exitCode >= 0)
+    return exitCode;
+
+  FontBuilder builder(options.params);
+
+  if(!builder.GenerateFontFile() ||
+     (options.verify && !builder.VerifyFontFile()) ||
+     !builder.WriteOutputFile(options.outputName))
+    {
+    fprintf(stderr, "%s: %s\n", options.outputName.c_str(), builder.Error().c_str());
+    return 1;
+    }
+
+  if(!builder.Warning().empty())
+    fprintf(stderr, "%s: warning: %s\n", options.outputName.c_str(), builder.Warning().c_str());
+
+  if(options.verbose)
+    PrintReport(options.outputName, builder);
+
+  if(!options.reportName.empty())
+    {
+    std::string fonts;
+    builder.FormatJsonReport(options.outputName, fonts);
+    if(!WriteReportFile(options.reportName, fonts))
+      return 1;
+    }
+
+  return 0;
+  }
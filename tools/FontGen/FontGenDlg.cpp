@@ -4,9 +4,7 @@
 #include "stdafx.h"
 #include "FontGen.h"
 #include "FontGenDlg.h"
-#include <compressapi.h>
-
-#include <stdint.h>
+#include "FontBuilder.h"
 
 #ifdef _DEBUG
 #define new DEBUG_NEW
@@ -14,6 +12,27 @@
 static char THIS_FILE[] = __FILE__;
 #endif
 
+// the builder takes UTF-8, the dialog text is in the ANSI code page
+static std::string ToUtf8(LPCTSTR text)
+  {
+#if defined(_UNICODE)
+  const WCHAR *wide = text;
+#else
+  int wideLen = MultiByteToWideChar(CP_ACP, 0, text, -1, NULL, 0);
+  std::vector<WCHAR> wideText(wideLen > 0 ? wideLen : 1, 0);
+  MultiByteToWideChar(CP_ACP, 0, text, -1, &wideText[0], wideLen);
+  const WCHAR *wide = &wideText[0];
+#endif
+
+  int len = WideCharToMultiByte(CP_UTF8, 0, wide, -1, NULL, 0, NULL, NULL);
+  if(len <= 1)
+    return std::string();
+
+  std::string utf8(len - 1, 0);
+  WideCharToMultiByte(CP_UTF8, 0, wide, -1, &utf8[0], len, NULL, NULL);
+  return utf8;
+  }
+
 
 /////////////////////////////////////////////////////////////////////////////
 // CAboutDlg dialog used for App About
@@ -60,8 +79,6 @@ BEGIN_MESSAGE_MAP(CAboutDlg, CDialog)
 	//}}AFX_MSG_MAP
 END_MESSAGE_MAP()
 
-static const TCHAR *defaultCharSet = _T("ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789!\"#$%&'(){}*+-,./\\[]^_`:;<=>?@~| ");
-
 /////////////////////////////////////////////////////////////////////////////
 // CFontGenDlg dialog
 
@@ -76,7 +93,9 @@ CFontGenDlg::CFontGenDlg(CWnd* pParent /*=NULL*/)
 	m_strSize = _T("");
 	m_strFontFace = _T("");
 	m_strFilename = _T("");
-  m_strCharSet = defaultCharSet;
+	m_nStartAngle = 0;
+	m_nStepAngle = 0;
+  m_strCharSet = FontParams::DefaultCharSet();
   m_nOutputType = 0;
 	//}}AFX_DATA_INIT
 	// Note that LoadIcon does not require a subsequent DestroyIcon in Win32
@@ -315,7 +334,25 @@ void CFontGenDlg::OnOK()
   m_sizes.Add(15);
   m_sizes.Add(18);
 
-  if(GenerateFontFile())
+  FontParams params;
+  params.fontFace = (LPCTSTR) m_strFontFace;
+  params.fontName = (LPCTSTR) m_strFontName;
+  params.charSet = ToUtf8(m_strCharSet);
+  params.fontWeight = m_nFontWeight;
+  params.italic = m_bItalic != FALSE;
+  params.underline = m_bUnderline != FALSE;
+  params.outputType = m_nOutputType;
+  // a step of 0 is upright only, otherwise a full turn from the start
+  params.startAngle = (int) m_nStartAngle;
+  params.stepAngle = (int) m_nStepAngle;
+  params.endAngle = params.startAngle + 360;
+
+  for(int i = 0; i < m_sizes.GetSize(); i++)
+    params.sizes.push_back(m_sizes[i]);
+
+  FontBuilder builder(params);
+
+  if(builder.GenerateFontFile())
     {
     TCHAR baseName[_MAX_PATH];
 
@@ -327,22 +364,10 @@ void CFontGenDlg::OnOK()
     _tmakepath(baseName, drive, path, fname, NULL);
 
     CString dataName = baseName;
+    dataName += FontBuilder::OutputExtension(m_nOutputType);
 
-    switch(m_nOutputType)
-      {
-      case 0:
-        dataName += ".c";
-        WriteCOutputFile(dataName);
-        break;
-      case 1:
-        dataName += ".txt";
-        WriteBase64OutputFile(dataName);
-        break;
-      case 2:
-        dataName += ".fon";
-        WriteBinaryOutputFile(dataName);
-        break;
-      }
+    if(!builder.WriteOutputFile((LPCTSTR) dataName))
+      AfxMessageBox(builder.Error().c_str());
 
     AfxGetApp()->WriteProfileString(szParams, szName, m_strFontName);
     AfxGetApp()->WriteProfileString(szParams, szFont, m_strFontFace);
@@ -351,6 +376,8 @@ void CFontGenDlg::OnOK()
     AfxGetApp()->WriteProfileInt(szParams, szWeight, m_nFontWeight);
     AfxGetApp()->WriteProfileString(szParams, szFilename, m_strFilename);
     }
+  else
+    AfxMessageBox(builder.Error().c_str());
 
 	CDialog::OnOK();
 	}
@@ -365,672 +392,6 @@ void CFontGenDlg::OnChangeFilename()
 	UpdateData();
 	}
 
-class CharMap {
-public:
-  UINT16 start;
-  UINT16 end;
-  CArray<UINT16> glyphOffsets;
-
-  CharMap()
-    {
-    start = 0;
-    end = 0;
-    }
-
-  CharMap &operator =(const CharMap &other)
-    {
-    start = other.start;
-    end = other.end;
-    glyphOffsets.RemoveAll();
-    glyphOffsets.Append(other.glyphOffsets);
-    return *this;
-    }
-  };
-
-class CSortCharArray : public CArray <TCHAR>
-  {
-  static int Compare(const void *, const void *);
-public:
-  void Sort()
-    {
-    qsort(GetData(), GetSize(), sizeof(TCHAR), Compare);
-    };
-  TCHAR * Search(TCHAR i)
-    {
-    return (TCHAR *)bsearch(&i, GetData(), GetSize(), sizeof(TCHAR), Compare);
-    };
-  };
-
-int CSortCharArray::Compare(const void *arg1, const void *arg2)
-  {
-  TCHAR int1 = *(TCHAR *)arg1;
-  TCHAR int2 = *(TCHAR *)arg2;
-
-  if(int1 < int2)
-    return -1;
-  else
-    if(int1 > int2)
-      return +1;
-  return 0;
-  }
-
-// variable length..
-struct glyph_t {
-  uint8_t advance;           // advance for the glyph
-  uint8_t baseline;          // baseline of the bitmap.
-  uint8_t offset;            // offset to first column of bitmap
-  uint8_t width;             // width of the bitmap
-  uint8_t height;            // height of the bitmap
-  uint8_t pixels[];
-  };
-
-
-BOOL CFontGenDlg::GenerateFontFile()
-  {
-
-  // calc the size of the matrix
-  CWindowDC sdc(this);
-
-  CDC dc;
-  dc.CreateCompatibleDC(&sdc);
-
-  // this sets how many columns for each character
-  CArray<int> charWidths;
-
-  int nMaxWidth = 0;
-
-  int nBytes = 0;
-
-  // A raster font stream is defined as the following format
-  //
-  // uint32_t magic	                  // can be:
-                                      // FONT - non compressed binary font image
-                                      // CFNT - compressed binary image
-  // char name[REG_NAME_MAX]          // name of the font. (16 chars)
-  // uint16_t file_length;            // un-compressed file length
-  // uint8_t num_fonts               // number of fixed size fonts
-  // uint8_t reserved[9]
-  // the following record is repeated for num_fonts
-  // -- if the file type is CFNT then all that remains is compressed ---
-  // uint16_t record_size;            // length of this font record.
-  // uint8_t size;                   // height of the font this bitmap renders
-  // uint8_t vertical_height;        // height including ascender/descender
-  // uint8_t baseline;               // where logical 0 is for the font outline.
-  // uint8_t num_maps                // number of character maps
-  // the character maps then continue for the num_maps
-  // uint8_t start_char              // first character in the character map
-  // uint8_t last_char               // last character in the character map
-  // uint16_t glyphs_offset[]         // offset to the glyph records (offset from start of the block)
-  // each glyph is indexed based on this number
-  // The glyphs then follow in the following format
-  // uint8_t glyph_advance           // horizontal advance for the glyph
-  // uint8_t glyph_baseline          // baseline of the bitmap, is aligned to the baseline when rendered
-  // uint8_t glyph_offset;           // offset to col 0 of the glyph
-  // uint8_t width                   // width of the actual glyph
-  // uint8_t height                  // height of the glyph
-  // uint8_t bitmap[width * height]   // alpha values of the bitmap
-  // ----- End of deflated record
-
-  UINT16 numFonts = m_sizes.GetCount();
-
-  CSortCharArray chars;
-
-  for(int c = 0; c < m_strCharSet.GetLength(); c++)
-    chars.Add(m_strCharSet[c]);
-
-  // sort the array
-  chars.Sort();
-
-  CArray<CharMap> charMaps;
-  CharMap nextMap;
-  nextMap.start = chars[0];
-  nextMap.end = chars[0];
-
-  // set the initial offset
-  uint16_t glyphOffset = 8;
-
-  for(int c = 1; c < chars.GetSize(); c++)
-    {
-    if(nextMap.start + c != chars[c])
-      {
-      // add the size of this map
-      glyphOffset += 2 + ((nextMap.end - nextMap.start + 1) << 1);
-      charMaps.Add(nextMap);
-      nextMap.start = chars[c];
-      nextMap.end = chars[c];
-      }
-    else
-      nextMap.end = chars[c];
-    }
-
-  // add the last one
-  charMaps.Add(nextMap);
-  // add the size of this map
-  glyphOffset += 2 + ((nextMap.end - nextMap.start + 1) << 1);
-
-  // now adjust the offset to a 16 byte boundary
-  glyphOffset = ((glyphOffset - 1) | 15) + 1;
-
-  CArray<UINT8> fontRec;      // built font record.
-  CArray<glyph_t *> glyphs;
-  CArray<UINT8> outRec;       // buffer that can me compressed
-
-  for(UINT16 fontNum = 0; fontNum < numFonts; fontNum++)
-    {
-    fontRec.RemoveAll();
-    charMaps[0].glyphOffsets.RemoveAll();
-
-    CFont fnt;
-    fnt.CreateFont(m_sizes[fontNum], 0, 0, 0, m_nFontWeight, m_bItalic, m_bUnderline,
-      0, 0, OUT_DEFAULT_PRECIS, CLIP_DEFAULT_PRECIS, DEFAULT_QUALITY, FF_DONTCARE | DEFAULT_PITCH,
-      m_strFontFace);
-    //fnt.CreatePointFont(m_sizes[fontNum] * 10, m_strFontFace);
-    dc.SelectObject(fnt);
-
-    OUTLINETEXTMETRIC otm;
-    GetOutlineTextMetrics(dc, sizeof(OUTLINETEXTMETRIC), &otm);
-
-    CSize fontBox(otm.otmTextMetrics.tmMaxCharWidth, otm.otmTextMetrics.tmHeight);
-
-    // create a bitmap
-    CBitmap bm;
-    bm.CreateCompatibleBitmap(&dc, fontBox.cx, fontBox.cy);
-
-    // white is the foreground color
-    dc.SelectObject(&bm);
-    dc.SetTextColor(0xFFFFFF);
-    dc.SetBkColor(0);
-
-    uint16_t currentGlyphOffset = glyphOffset;
-
-    // build the array of variable length glyphs based on the charmaps
-    int charMap = 0;
-    for(int glyph = 0; glyph < chars.GetSize(); glyph++)
-      {
-      TCHAR ch[2] = { chars[glyph], 0 };
-      CSize w = dc.GetTextExtent(ch, 1);
-      if(charMaps[charMap].end < chars[glyph])
-        {
-        // next map
-        charMap++;
-        charMaps[charMap].glyphOffsets.RemoveAll();
-        }
-
-      uint16_t advance = w.cx;
-      uint16_t x_offset = 0;
-      uint16_t y_offset = 0;
-      uint16_t stride = 0;
-
-      uint16_t numBytes = sizeof(glyph_t);
-
-      // store where we are
-      charMaps[charMap].glyphOffsets.Add(currentGlyphOffset);
-
-      if (ch[0] != ' ')
-        {
-        for (int row = 0; row < w.cy; row++)
-          {
-          for (int col = 0; col < w.cx; col++)
-            {
-            dc.SetPixel(col, row, 0);
-            }
-          }
-
-        if (!dc.ExtTextOut(0, 0, 0, NULL, ch, 1, NULL))
-          {
-          AfxMessageBox(_T("Cannot render the bitmap"));
-          return FALSE;
-          }
-
-        bool isBlank;
-
-        // Scan the generated bitmap.  Columns that are empty
-        // to the left are ignored
-        for (int col = 0; col < w.cx; col++)
-          {
-          isBlank = true;
-          for (int row = 0; row < w.cy; row++)
-            {
-            if (dc.GetPixel(col, row) != 0)
-              {
-              isBlank = false;
-              break;
-              }
-            }
-
-          if (!isBlank)
-            break;
-
-          x_offset++;
-          }
-
-        // Scan the generated bitmap.  Columns that are empty
-        // to the right are ignored
-        for (int col = w.cx; col > 0; col--)
-          {
-          isBlank = true;
-          for (int row = 0; row < w.cy; row++)
-            {
-            if (dc.GetPixel(col - 1, row) != 0)
-              {
-              isBlank = false;
-              break;
-              }
-            }
-
-          if (!isBlank)
-            break;
-
-          w.cx--;
-          }
-
-        // Scan the bitmap for empty rows
-        for (int row = 0; row < w.cy; row++)
-          {
-          isBlank = true;
-          for (int col = x_offset; col < w.cx; col++)
-            {
-            if (dc.GetPixel(col, row) != 0)
-              {
-              isBlank = false;
-              break;
-              }
-            }
-
-          if (!isBlank)
-            break;
-          y_offset++;
-          }
-
-        // Scan the bitmap for empty rows
-        for (int row = w.cy; row > y_offset; row--)
-          {
-          isBlank = true;
-          for (int col = x_offset; col < advance; col++)
-            {
-            if (dc.GetPixel(col, row - 1) != 0)
-              {
-              isBlank = false;
-              break;
-              }
-            }
-
-          if (!isBlank)
-            break;
-
-          w.cy--;
-          }
-
-        // remove the offset from the width
-        w.cy -= y_offset;
-        w.cx -= x_offset;
-
-        stride = (((w.cx - 1) | 7) + 1) >> 3;
-
-        numBytes += stride * w.cy;
-        }
-
-      // roung the glyph to the nearest page
-      numBytes = ((numBytes - 1) | 15) + 1;
-      glyph_t *pGlyph = (glyph_t *)malloc(numBytes);
-
-      // round to 16 byte boundary
-      currentGlyphOffset += numBytes;
-
-      memset(pGlyph, 0, numBytes);
-
-      glyphs.Add(pGlyph);
-      pGlyph->advance = advance;
-      pGlyph->baseline = otm.otmTextMetrics.tmAscent;
-
-      if (ch[0] != ' ')
-        {
-        // remove the rows at the top that are blank.
-        pGlyph->baseline -= y_offset;
-
-        pGlyph->width = w.cx;
-        pGlyph->height = w.cy;
-
-        for (int row = 0; row < w.cy; row++)
-          {
-          for (int col = 0; col < w.cx; col += 8)
-            {
-            // raster-font
-            BYTE pixel = 0;
-            int bit;
-            for (bit = 0; bit < 8 && (col + bit) < w.cx; bit++)
-              {
-              pixel <<= 1;
-              if (dc.GetPixel(col + bit + x_offset, row + y_offset) != 0)
-                pixel |= 1;
-              }
-
-            // shift the pel's
-            while (bit < 8)
-              {
-              pixel <<= 1;
-              bit++;
-              }
-            pGlyph->pixels[(col >> 3) + (row * stride)] = pixel;
-            }
-          }
-        }
-      
-#ifdef _DEBUG_FONT
-      {
-      static TCHAR buf[256];
-      snprintf(buf, 256, "Character 0x%02.2x\r\n", ch[0]);
-      OutputDebugString(buf);
-      snprintf(buf, 256, "Offset : %d\r\n", currentGlyphOffset - numBytes);
-      OutputDebugString(buf);
-      snprintf(buf, 256, "-------------------\r\n");
-      OutputDebugString(buf);
-      for(int row = 0; row < w.cy; row++)
-        {
-        for(int col = 0; col < w.cx; col += 8)
-          {
-          snprintf(buf, 256, "0x%02.2x ", pGlyph->pixels[(col >> 3) + (row * stride)]);
-          OutputDebugString(buf);
-          }
-        snprintf(buf, 256, "\r\n");
-        OutputDebugString(buf);
-        }
-      snprintf(buf, 256, "-------------------\r\n");
-      OutputDebugString(buf);
-      }
-#endif
-
-      }
-
-    // uint8_t size;                   // height of the font this bitmap renders
-    fontRec.Add(m_sizes[fontNum]);
-    // uint8_t vertical_height;        // height including ascender/descender
-    fontRec.Add(fontBox.cy);
-    // uint8_t baseline;               // we assume the baseline is same as the height - could be wrong
-    fontRec.Add(otm.otmTextMetrics.tmAscent);
-    // uint8_t num_maps                // number of character maps
-    fontRec.Add(charMaps.GetSize());
-    // Reserved
-    fontRec.Add(0);
-    fontRec.Add(0);
-
-    int byte = 0;
-    // dump the bitmaps.
-    for(int n = 0; n < charMaps.GetSize(); n++)
-      {
-      CharMap &map = charMaps[n];
-
-      // uint_t start_char              // first character in the character map
-      fontRec.Add(map.start);
-      // uint8_t last_char               // last character in the character map
-      fontRec.Add(map.end);
-
-      // uint16_t glyphs_offset           // offset to the glyph records (offset from start of the block)
-      uint16_t numGlyphs = map.glyphOffsets.GetSize();
-      ASSERT(numGlyphs == (map.end - map.start + 1));
-      for(int i = 0; i < numGlyphs; i++)
-        {
-        uint16_t offset = map.glyphOffsets[i];
-        fontRec.Add(offset >> 8);
-        fontRec.Add(offset);
-        }
-      }
-
-    // adjust to 16 byte boundary
-    uint16_t pos = fontRec.GetSize();
-    pos += 2;       // adjust for the 2 bytes added when the record length is added
-
-    while ((pos & 0x0f) > 0)
-      {
-      fontRec.Add(0);
-      pos++;
-      }
-
-    // dump the glyphs
-    for(int n = 0; n < glyphs.GetSize(); n++)
-      {
-      glyph_t *pGlyph = glyphs[n];
-      // uint8_t glyph_advance           // horizontal advance for the glyph
-      fontRec.Add(pGlyph->advance);
-      // uint8_t glyph_baseline          // baseline of the bitmap, is aligned to the baseline when rendered
-      fontRec.Add(pGlyph->baseline);
-      // uint8_t offset                  // offset to column 0
-      fontRec.Add(pGlyph->offset);
-      // uint8_t width                   // width of the actual glyph
-      fontRec.Add(pGlyph->width);
-      // uint8_t height                  // height of the glyph
-      fontRec.Add(pGlyph->height);
-
-      int recLen = 5;
-      uint16_t stride = (((pGlyph->width - 1) | 7) + 1) >> 3;
-      // uint8_t bitmap[width * height]   // alpha values of the bitmap
-      for(int row = 0; row < pGlyph->height; row++)
-        {
-        for(int col = 0; col < pGlyph->width; col+=8)
-          {
-          fontRec.Add(pGlyph->pixels[(col >> 3) + (row * stride)]);
-          recLen++;
-          }
-        }
-
-      int pad;
-      for (pad = recLen; pad < (((recLen - 1) | 15) + 1); pad++)
-        fontRec.Add(0);     // pad to 16 byte boundary
-
-      // free the glyph
-      free(pGlyph);
-      }
-
-    glyphs.RemoveAll();
-
-    uint16_t len = fontRec.GetSize();
-    len += 2;
-
-    // uint16_t record_size;            // length of this font record.
-    outRec.Add(len >> 8);
-    outRec.Add(len);
-
-    outRec.Append(fontRec);       // uncompressed font file
-    }
-
-  if(m_nOutputType == 0)
-    {
-    m_fontFile.Add('F');
-    m_fontFile.Add('O');
-    m_fontFile.Add('N');
-    m_fontFile.Add('T');
-    }
-  else
-    {
-    m_fontFile.Add('C');
-    m_fontFile.Add('F');
-    m_fontFile.Add('N');
-    m_fontFile.Add('T');
-    }
-
-  // add the uncompressed file name.
-  int i;
-  for(i = 0; i < m_strFontName.GetLength() && i < 16; i++)
-    {
-    m_fontFile.Add(m_strFontName[i]);
-    }
-
-  while(i < 16)
-    {
-    m_fontFile.Add(0x00);
-    i++;
-    }
-
-  uint32_t fileLength = outRec.GetSize();
-  fileLength += 32;
-  if (fileLength > 65535)
-    {
-    AfxMessageBox(_T("The generated font file exceeds the maximumm size.  Must be < 65535 bytes.  Remove pixel sizes or characters"));
-    return FALSE;
-    }
-
-
-  m_fontFile.Add(fileLength >> 8);
-  m_fontFile.Add(fileLength);
-
-  m_fontFile.Add(numFonts);
-
-  // reserved bytes (9)
-  m_fontFile.Add(0);
-  m_fontFile.Add(0);
-  m_fontFile.Add(0);
-  m_fontFile.Add(0);
-  m_fontFile.Add(0);
-  m_fontFile.Add(0);
-  m_fontFile.Add(0);
-  m_fontFile.Add(0);
-  m_fontFile.Add(0);
-
-  if(m_nOutputType == 0)
-    m_fontFile.Append(outRec);            // binary file.
-  else
-    {
-    // calculate the compressed size.
-    COMPRESSOR_HANDLE Compressor = NULL;
-    PBYTE CompressedBuffer = NULL;
-    SIZE_T CompressedDataSize, CompressedBufferSize;
-
-    BOOL Success = CreateCompressor(
-      COMPRESS_ALGORITHM_XPRESS_HUFF, //  Compression Algorithm
-      NULL,                           //  Optional allocation routine
-      &Compressor);                   //  Handle
-                                      //  Query compressed buffer size.
-    Success = Compress(
-      Compressor,                  //  Compressor Handle
-      outRec.GetData(),        //  Input buffer, Uncompressed data
-      outRec.GetSize(),         //  Uncompressed data size
-      NULL,                        //  Compressed Buffer
-      0,                           //  Compressed Buffer size
-      &CompressedBufferSize);      //  Compressed Data size
-
-                                    //  Allocate memory for compressed buffer.
-    if(!Success)
-      {
-      DWORD ErrorCode = GetLastError();
-
-      if(ErrorCode != ERROR_INSUFFICIENT_BUFFER)
-        {
-        AfxMessageBox(_T("Cannot compress font record"));
-        return FALSE;
-        }
-
-      CompressedBuffer = (PBYTE)malloc(CompressedBufferSize);
-      if(!CompressedBuffer)
-        {
-        AfxMessageBox(_T("Cannot allocate memory for compressed buffer.\n"));
-        return FALSE;
-        }
-      }
-
-    //  Call Compress() again to do real compression and output the compressed
-    //  data to CompressedBuffer.
-    Success = Compress(
-      Compressor,             //  Compressor Handle
-      outRec.GetData(),        //  Input buffer, Uncompressed data
-      outRec.GetSize(),         //  Uncompressed data size
-      CompressedBuffer,       //  Compressed Buffer
-      CompressedBufferSize,   //  Compressed Buffer size
-      &CompressedDataSize);   //  Compressed Data size
-
-    if(!Success)
-      {
-      AfxMessageBox(_T("Cannot compress data: %d\n"), GetLastError());
-      return FALSE;
-      }
-
-    // append the compressed record.
-    for(SIZE_T n = 0; n < CompressedDataSize; n++)
-      m_fontFile.Add(CompressedBuffer[n]);
-
-    free(CompressedBuffer);
-    }
-
-  return TRUE;
-  }
-
-BOOL CFontGenDlg::WriteCOutputFile(CString &dataName)
-  {
-  CStdioFile data(dataName, CFile::modeCreate | CFile::modeWrite);
-
-  data.WriteString("#include <stdint.h>\n");
-  data.WriteString("/* autogenerated file.  Do not edit\n");
-  data.WriteString("Font name: ");
-  data.WriteString(m_strFontName);
-  data.WriteString("\nCharacter set : ");
-  data.WriteString(m_strCharSet);
-  data.WriteString("\nPixel sizes : ");
-
-  for (int i = 0; i < m_sizes.GetSize(); i++)
-    {
-    TCHAR buffer[64];
-    data.WriteString(itoa(m_sizes[i], buffer, 10));
-    data.WriteString(" ");
-    }
-  
-  data.WriteString("\n*/\n\n");
-  data.WriteString("const uint8_t ");
-  data.WriteString(m_strFontName);
-  data.WriteString("[] = {\n");
-
-  TCHAR hexBuf[16];
-
-  for(int bo = 0; bo < m_fontFile.GetSize(); bo++)
-    {
-    if((bo & 0x0f) == 0)
-      data.WriteString("\n");
-
-    _stprintf(hexBuf, _T("0x%02.2x, "), m_fontFile[bo]);
-    data.WriteString(hexBuf);
-    }
-
-  data.WriteString("};\n");
-
-  data.WriteString("const uint16_t ");
-  data.WriteString(m_strFontName);
-  data.WriteString("_length = ");
-  _stprintf(hexBuf, _T("%d"), m_fontFile.GetSize());
-  data.WriteString(hexBuf);
-  data.WriteString(";\n");
-
-  data.Close();
-  return TRUE;
-  }
-
-#include <wincrypt.h>
-
-BOOL CFontGenDlg::WriteBase64OutputFile(CString &dataName)
-  {
-  CStdioFile data(dataName, CFile::modeCreate | CFile::modeWrite);
-
-  DWORD len;
-  if(CryptBinaryToString(m_fontFile.GetData(), m_fontFile.GetSize(), CRYPT_STRING_BASE64, NULL, &len))
-    {
-    TCHAR *file = (TCHAR *) malloc(len * sizeof(TCHAR));
-
-    if(CryptBinaryToString(m_fontFile.GetData(), m_fontFile.GetSize(), CRYPT_STRING_BASE64, file, &len))
-      data.WriteString(file);
-
-    free(file);
-    }
-  data.Close();
-  return TRUE;
-  }
-
-BOOL CFontGenDlg::WriteBinaryOutputFile(CString &dataName)
-  {
-  CFile data(dataName, CFile::modeCreate | CFile::modeWrite);
-
-  data.Write(m_fontFile.GetData(), m_fontFile.GetSize());
-
-  data.Close();
-  return TRUE;
-  }
-
 void CFontGenDlg::OnLbnSelchangeFontsizes()
   {
   // TODO: Add your control notification handler code here
@@ -1092,5 +453,5 @@ void CFontGenDlg::OnEnChangeCharacterSet()
 
 void CFontGenDlg::OnBnClickedDefaultSet()
   {
-  m_strCharSet = defaultCharSet;
+  m_strCharSet = FontParams::DefaultCharSet();
   }
@@ -54,15 +54,6 @@ protected:
 	//}}AFX_MSG
 	DECLARE_MESSAGE_MAP()
 
-  CArray<UINT8> m_fontFile;
-
-  // generate a font file
-  BOOL GenerateFontFile();
-  BOOL WriteCOutputFile(CString &fileName);
-  BOOL WriteBase64OutputFile(CString &fileName);
-  BOOL WriteBinaryOutputFile(CString &fileName);
-
-
 public:
   // Type of output, 0=c, 1=base64, 2=binary
   int m_nOutputType;
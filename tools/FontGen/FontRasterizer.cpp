@@ -0,0 +1,150 @@
+// FontRasterizer.cpp : selects the rasterizer for a font face
+//
+
+#include <math.h>
+#include <string.h>
+
+#include "FontBuilder.h"
+#include "FontRasterizer.h"
+
+// true if the face names a font file rather than an installed face
+static bool IsFontFile(const std::string &face)
+  {
+  static const char *extensions[] = { ".ttf", ".otf", ".ttc", ".TTF", ".OTF", ".TTC" };
+
+  if(face.length() < 4)
+    return false;
+
+  const char *ext = face.c_str() + face.length() - 4;
+  for(size_t i = 0; i < sizeof(extensions) / sizeof(extensions[0]); i++)
+    if(strcmp(ext, extensions[i]) == 0)
+      return true;
+
+  return false;
+  }
+
+bool FontRasterizer::RenderGlyphs(const uint32_t *chars, size_t count, std::vector<GlyphBitmap> &bitmaps)
+  {
+  bitmaps.resize(count);
+
+  for(size_t i = 0; i < count; i++)
+    if(!RenderGlyph(chars[i], bitmaps[i]))
+      return false;
+
+  return true;
+  }
+
+// bilinear sample of a cell, outside the cell is background
+static double SampleCoverage(const GlyphBitmap &cell, double x, double y)
+  {
+  int x0 = (int) floor(x);
+  int y0 = (int) floor(y);
+  double fx = x - x0;
+  double fy = y - y0;
+
+  double value = 0;
+  for(int j = 0; j < 2; j++)
+    for(int i = 0; i < 2; i++)
+      {
+      int col = x0 + i;
+      int row = y0 + j;
+      if(col < 0 || col >= cell.width || row < 0 || row >= cell.height)
+        continue;
+
+      double weight = (i ? fx : 1 - fx) * (j ? fy : 1 - fy);
+      value += weight * cell.Pixel(col, row);
+      }
+
+  return value;
+  }
+
+bool FontRasterizer::RenderRotated(uint32_t ch, int angle, GlyphBitmap &bitmap)
+  {
+  GlyphBitmap cell;
+  if(!RenderGlyph(ch, cell))
+    return false;
+
+  int ascent = Metrics().ascent;
+  double rad = angle * 3.14159265358979323846 / 180;
+  double c = cos(rad);
+  double s = sin(rad);
+
+  // the rotated corners of the cell relative to the pen, y is down so a
+  // counterclockwise turn is x' = x cos + y sin, y' = y cos - x sin
+  double minX = 0, minY = 0, maxX = 0, maxY = 0;
+  for(int corner = 0; corner < 4; corner++)
+    {
+    double x = (corner & 1) ? cell.width : 0;
+    double y = ((corner & 2) ? cell.height : 0) - ascent;
+    double rx = x * c + y * s;
+    double ry = y * c - x * s;
+
+    if(corner == 0 || rx < minX) minX = rx;
+    if(corner == 0 || rx > maxX) maxX = rx;
+    if(corner == 0 || ry < minY) minY = ry;
+    if(corner == 0 || ry > maxY) maxY = ry;
+    }
+
+  int left = (int) floor(minX + 0.001);
+  int top = (int) floor(minY + 0.001);
+
+  bitmap.width = (int) ceil(maxX - 0.001) - left;
+  bitmap.height = (int) ceil(maxY - 0.001) - top;
+  bitmap.originX = -left;
+  bitmap.originY = -top;
+  bitmap.advance = cell.width;
+  bitmap.coverage.assign(bitmap.width * bitmap.height, 0);
+
+  // a monochrome cell stays monochrome
+  bool mono = true;
+  for(size_t i = 0; i < cell.coverage.size() && mono; i++)
+    mono = cell.coverage[i] == 0 || cell.coverage[i] == 255;
+
+  // each pixel center is turned back into the upright cell
+  for(int row = 0; row < bitmap.height; row++)
+    for(int col = 0; col < bitmap.width; col++)
+      {
+      double x = col + left + 0.5;
+      double y = row + top + 0.5;
+      double ux = x * c - y * s;
+      double uy = x * s + y * c + ascent;
+
+      double value = SampleCoverage(cell, ux - 0.5, uy - 0.5);
+      uint8_t &pixel = bitmap.coverage[row * bitmap.width + col];
+      if(mono)
+        pixel = value >= 128 ? 255 : 0;
+      else
+        pixel = (uint8_t)(value + 0.5);
+      }
+
+  return true;
+  }
+
+FontRasterizer *FontRasterizer::Create(const FontParams &params, std::string &error)
+  {
+  int type = params.rasterizer;
+
+  if(type == RASTERIZER_DEFAULT)
+    type = IsFontFile(params.fontFace) ? RASTERIZER_FREETYPE : RASTERIZER_GDI;
+
+  switch(type)
+    {
+    case RASTERIZER_GDI:
+#if defined(_WIN32)
+      return CreateGdiRasterizer(params, error);
+#else
+      error = "GDI is only available on Windows, use a font file";
+      return NULL;
+#endif
+    case RASTERIZER_FREETYPE:
+#if defined(FONTGEN_HAVE_FREETYPE)
+      return CreateFreeTypeRasterizer(params, error);
+#else
+      error = "FontGen was built without FreeType support";
+      return NULL;
+#endif
+    }
+
+  error = "Unknown rasterizer";
+  return NULL;
+  }
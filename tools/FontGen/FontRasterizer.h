@@ -0,0 +1,123 @@
+// FontRasterizer.h : interface to the glyph rasterizers
+//
+// The font builder only needs the cell metrics of a pixel size, the
+// extent of a glyph and a coverage bitmap of the glyph cell.  GDI
+// provides these on Windows, FreeType renders TTF/OTF files everywhere.
+//
+
+#if !defined(FONTGEN_FONTRASTERIZER_H)
+#define FONTGEN_FONTRASTERIZER_H
+
+#if _MSC_VER > 1000
+#pragma once
+#endif // _MSC_VER > 1000
+
+#include <stdint.h>
+#include <string>
+#include <vector>
+
+struct FontParams;
+
+// metrics of the selected pixel size
+struct RasterMetrics
+  {
+  int height;               // height including ascender/descender (tmHeight)
+  int ascent;               // rows from the top of the cell to the baseline (tmAscent)
+  int maxCharWidth;         // widest advance in the face (tmMaxCharWidth)
+  };
+
+// coverage of one character cell.  The cell is advance pixels wide and
+// the font height tall with the baseline at the ascent.  0 is background,
+// 255 is solid ink.  A 1 bit per pixel font is rendered without
+// antialiasing so any ink is 255.  A rotated cell is only as large as
+// the rotated glyph, the origin is where the pen sits in it.
+//
+// RenderGlyphs of a 1 bit per pixel font may instead deliver a packed
+// cell, already trimmed to its ink.  The ink box is in cell pixels, bits
+// holds its rows of FontStride(inkWidth) bytes with the leftmost pixel
+// in the top bit and the coverage is empty.  A blank cell has no ink
+struct GlyphBitmap
+  {
+  GlyphBitmap()
+    {
+    width = 0;
+    height = 0;
+    originX = 0;
+    originY = 0;
+    advance = 0;
+    packed = false;
+    inkLeft = 0;
+    inkTop = 0;
+    inkWidth = 0;
+    inkHeight = 0;
+    }
+
+  int width;
+  int height;
+  std::vector<uint8_t> coverage;      // width * height, row major
+  int originX;                        // rotated cells only
+  int originY;
+  int advance;                        // upright advance of a rotated cell
+  bool packed;                        // bits and the ink box, not coverage
+  int inkLeft;
+  int inkTop;
+  int inkWidth;                       // 0 if the cell is blank
+  int inkHeight;
+  std::vector<uint8_t> bits;          // packed rows of the ink
+
+  uint8_t Pixel(int col, int row) const { return coverage[row * width + col]; }
+  };
+
+enum RasterizerType
+  {
+  RASTERIZER_DEFAULT = 0,   // FreeType for font files, GDI for installed faces
+  RASTERIZER_GDI = 1,
+  RASTERIZER_FREETYPE = 2,
+  };
+
+class FontRasterizer
+  {
+public:
+  virtual ~FontRasterizer() {}
+
+  // select the pixel size that the following calls render
+  virtual bool SelectSize(int pixels) = 0;
+  virtual const RasterMetrics &Metrics() const = 0;
+  // horizontal advance of a character
+  virtual bool GlyphExtent(uint32_t ch, int &advance) = 0;
+  // render a character into its cell
+  virtual bool RenderGlyph(uint32_t ch, GlyphBitmap &bitmap) = 0;
+  // render a run of characters, one cell for each.  The default renders
+  // them one at a time, a rasterizer that can batch overrides this.  The
+  // cells may be packed, RenderGlyph always gives coverage
+  virtual bool RenderGlyphs(const uint32_t *chars, size_t count, std::vector<GlyphBitmap> &bitmaps);
+  // render a character turned angle degrees counterclockwise about the
+  // pen.  The default resamples the upright cell, a rasterizer that can
+  // transform its outlines overrides this
+  virtual bool RenderRotated(uint32_t ch, int angle, GlyphBitmap &bitmap);
+
+  const std::string &Error() const { return m_strError; }
+
+  // create the rasterizer the params ask for, returns NULL and sets
+  // error if the face cannot be loaded
+  static FontRasterizer *Create(const FontParams &params, std::string &error);
+
+protected:
+  bool Fail(const char *msg)
+    {
+    m_strError = msg;
+    return false;
+    }
+
+  std::string m_strError;
+  };
+
+#if defined(_WIN32)
+FontRasterizer *CreateGdiRasterizer(const FontParams &params, std::string &error);
+#endif
+
+#if defined(FONTGEN_HAVE_FREETYPE)
+FontRasterizer *CreateFreeTypeRasterizer(const FontParams &params, std::string &error);
+#endif
+
+#endif // !defined(FONTGEN_FONTRASTERIZER_H)
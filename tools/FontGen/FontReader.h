@@ -0,0 +1,772 @@
+// FontReader.h : zero-copy reader for FONT/CFNT font streams
+//
+// The views point into a buffer the caller owns: a font linked into the
+// image, in flash or mapped from a file.  Nothing is copied or allocated,
+// a view is a pointer and a length.  The layout is the one in FontFormat.h,
+// which the generator writes with the same constants.
+//
+// A file may carry sections, such as the ACCL lookup table, which are
+// read in place in both kinds of stream.
+//
+// A FONT stream is read in place.  A CFNT stream only has its header and
+// record directory readable in place.  The caller decompresses a record
+// (FontDecompress in FontCodec.h) into a buffer and views it with a
+// FontRecordView.
+//
+// Views are checked when they are made.  The accessors then trust them so
+// a glyph lookup is a few loads.  A record's char maps are checked as a
+// lookup walks them and a glyph when it is found, so a record that is
+// not whole finds no glyph rather than reading past its end.
+//
+
+#if !defined(FONTGEN_FONTREADER_H)
+#define FONTGEN_FONTREADER_H
+
+#if _MSC_VER > 1000
+#pragma once
+#endif // _MSC_VER > 1000
+
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+
+#include "FontFormat.h"
+
+// a glyph record.  A run length glyph is drawn straight from its runs:
+//
+//   const uint8_t *runs = glyph.Pixels();
+//   const uint8_t *last = runs;
+//   for(int row = 0; row < glyph.Height(); row++)
+//     {
+//     const uint8_t *p = *runs == FONT_RUNS_REPEAT ? last : runs;
+//     for(uint8_t n = *p++; n > 0; n--, p += 2)
+//       draw a line of p[1] pixels from column p[0]
+//     if(*runs != FONT_RUNS_REPEAT)
+//       last = runs;
+//     runs = *runs == FONT_RUNS_REPEAT ? runs + 1 : p;
+//     }
+//
+// A glyph is drawn with its top left pixel at (pen x + Left(), pen y -
+// Top()), the same for the upright and the rotated records
+class FontGlyphView
+  {
+public:
+  FontGlyphView()
+    {
+    m_glyph = NULL;
+    m_pixels = NULL;
+    m_bpp = 1;
+    m_encoding = FONT_GLYPH_RAW;
+    m_rotated = false;
+    }
+
+  // encoded is true if the record has FONT_RECORD_FLAG_ENCODED_GLYPHS,
+  // rotated if it has FONT_RECORD_FLAG_ROTATED
+  FontGlyphView(const glyph_t *glyph, int bpp, bool encoded = false, bool rotated = false)
+    {
+    m_glyph = glyph;
+    m_pixels = encoded ? glyph->pixels + 1 : glyph->pixels;
+    m_bpp = bpp;
+    m_encoding = encoded ? glyph->pixels[0] : FONT_GLYPH_RAW;
+    m_rotated = rotated;
+    }
+
+  bool IsValid() const { return m_glyph != NULL; }
+
+  uint8_t Advance() const { return m_glyph->advance; }
+  uint8_t Baseline() const { return m_glyph->baseline; }
+  uint8_t Offset() const { return m_glyph->offset; }
+  uint8_t Width() const { return m_glyph->width; }
+  uint8_t Height() const { return m_glyph->height; }
+  // columns from the pen to the bitmap and rows from the bitmap down to
+  // the pen, the placement of a rotated glyph is signed
+  int Left() const { return m_rotated ? (int8_t) m_glyph->offset : m_glyph->offset; }
+  int Top() const { return m_rotated ? (int8_t) m_glyph->baseline : m_glyph->baseline; }
+  int BitsPerPixel() const { return m_bpp; }
+  uint16_t Stride() const { return FontStride(m_glyph->width, m_bpp); }
+  // FONT_GLYPH_
+  int Encoding() const { return m_encoding; }
+  bool IsRunLength() const { return m_encoding == FONT_GLYPH_RUNS; }
+  // the bitmap, or the row runs of a run length glyph
+  const uint8_t *Pixels() const { return m_pixels; }
+  const glyph_t *Glyph() const { return m_glyph; }
+
+  // coverage of a pixel, 0 to (1 << bpp) - 1.  A run length glyph is
+  // walked to the row so drawing should use the runs
+  uint8_t Pixel(int col, int row) const
+    {
+    if(IsRunLength())
+      {
+      const uint8_t *runs = m_pixels;
+      const uint8_t *last = runs;
+      for(int r = 0; r < row; r++)
+        {
+        if(*runs == FONT_RUNS_REPEAT)
+          runs++;
+        else
+          {
+          last = runs;
+          runs += 1 + (*runs << 1);
+          }
+        }
+
+      if(*runs == FONT_RUNS_REPEAT)
+        runs = last;
+
+      for(uint8_t n = *runs++; n > 0; n--, runs += 2)
+        {
+        if(col >= runs[0] && col < runs[0] + runs[1])
+          return 1;
+        }
+
+      return 0;
+      }
+
+    const uint8_t *line = m_pixels + row * Stride();
+    int bit = col * m_bpp;
+    return (uint8_t)((line[bit >> 3] >> (8 - m_bpp - (bit & 7))) & ((1 << m_bpp) - 1));
+    }
+
+private:
+  const glyph_t *m_glyph;
+  const uint8_t *m_pixels;
+  int m_bpp;
+  int m_encoding;
+  bool m_rotated;
+  };
+
+// a char map: the first and last character and an offset for each
+class FontCharMapView
+  {
+public:
+  FontCharMapView()
+    {
+    m_map = NULL;
+    m_end = NULL;
+    m_offsetSize = 2;
+    m_headerSize = FONT_CHARMAP_HEADER_SIZE;
+    }
+
+  // wide maps hold 32 bit code points.  end is the end of the record, a
+  // map whose header or offsets do not fit before it is not valid
+  FontCharMapView(const uint8_t *map, const uint8_t *end, uint32_t offsetSize, bool wide)
+    {
+    m_map = NULL;
+    m_end = end;
+    m_offsetSize = offsetSize;
+    m_headerSize = FontCharMapHeaderSize(wide);
+
+    if(map == NULL || map > end || (uint32_t)(end - map) < m_headerSize)
+      return;
+
+    uint32_t start = FontGetBigEndian(map, m_headerSize >> 1);
+    uint32_t last = FontGetBigEndian(map + (m_headerSize >> 1), m_headerSize >> 1);
+    if(last < start || m_headerSize + ((uint64_t) last - start + 1) * offsetSize > (uint64_t)(end - map))
+      return;
+
+    m_map = map;
+    }
+
+  bool IsValid() const { return m_map != NULL; }
+
+  uint32_t Start() const { return FontGetBigEndian(m_map, m_headerSize >> 1); }
+  uint32_t Last() const { return FontGetBigEndian(m_map + (m_headerSize >> 1), m_headerSize >> 1); }
+  uint32_t NumChars() const { return Last() - Start() + 1; }
+  bool Contains(uint32_t ch) const { return ch >= Start() && ch <= Last(); }
+
+  // offset from the start of the record to the glyph of a character
+  uint32_t GlyphOffset(uint32_t ch) const
+    {
+    return FontGetBigEndian(m_map + m_headerSize + (ch - Start()) * m_offsetSize, m_offsetSize);
+    }
+
+  // bytes taken by the map
+  uint32_t Length() const { return m_headerSize + NumChars() * m_offsetSize; }
+  // the map after this one, the caller counts the maps
+  FontCharMapView Next() const
+    {
+    if(m_map == NULL)
+      return FontCharMapView();
+
+    return FontCharMapView(m_map + Length(), m_end, m_offsetSize, m_headerSize != FONT_CHARMAP_HEADER_SIZE);
+    }
+
+private:
+  const uint8_t *m_map;
+  const uint8_t *m_end;
+  uint32_t m_offsetSize;
+  uint32_t m_headerSize;
+  };
+
+// the ACCL section: where each character's glyph offset is in a record
+class FontAccelView
+  {
+public:
+  FontAccelView()
+    {
+    m_data = NULL;
+    m_numIndex = 0;
+    m_offsetSize = 2;
+    }
+
+  // length is the section data length, version is FONT_VERSION_
+  FontAccelView(const uint8_t *data, uint32_t length, int version)
+    {
+    m_data = NULL;
+    m_numIndex = 0;
+    m_offsetSize = FontOffsetSize(version);
+
+    if(data == NULL || length < 4)
+      return;
+
+    uint32_t numIndex = FontGetBigEndian(data, 4);
+    if(numIndex > (length - 4) >> 1)
+      return;
+
+    // every page an index names has to be in the section
+    uint32_t numPages = (length - 4 - (numIndex << 1)) / (m_offsetSize << 8);
+    for(uint32_t i = 0; i < numIndex; i++)
+      {
+      uint32_t page = FontGetBigEndian(data + 4 + (i << 1), 2);
+      if(page != FONT_ACCEL_NO_PAGE && page >= numPages)
+        return;
+      }
+
+    m_data = data;
+    m_numIndex = numIndex;
+    }
+
+  bool IsValid() const { return m_data != NULL; }
+
+  // position from the start of a record of the glyph offset of a
+  // character, 0 if the font does not have it
+  uint32_t Position(uint32_t ch) const
+    {
+    if((ch >> 8) >= m_numIndex)
+      return 0;
+
+    uint32_t page = FontGetBigEndian(m_data + 4 + ((ch >> 8) << 1), 2);
+    if(page == FONT_ACCEL_NO_PAGE)
+      return 0;
+
+    const uint8_t *entries = m_data + 4 + (m_numIndex << 1);
+    return FontGetBigEndian(entries + (((page << 8) | (ch & 0xFF)) * m_offsetSize), m_offsetSize);
+    }
+
+private:
+  const uint8_t *m_data;
+  uint32_t m_numIndex;
+  uint32_t m_offsetSize;
+  };
+
+// the glyph metrics of one record from the MTRX section, indexed by the
+// slot FontRecordView::CharSlot gives a character
+class FontMetricsView
+  {
+public:
+  FontMetricsView()
+    {
+    m_advance = NULL;
+    m_box = NULL;
+    m_numSlots = 0;
+    }
+
+  FontMetricsView(const uint8_t *advance, const uint8_t *box, uint32_t numSlots)
+    {
+    m_advance = advance;
+    m_box = box;
+    m_numSlots = numSlots;
+    }
+
+  bool IsValid() const { return m_advance != NULL; }
+
+  uint32_t NumSlots() const { return m_numSlots; }
+  // the advances of every slot, 0 for a hole
+  const uint8_t *Advances() const { return m_advance; }
+  uint8_t Advance(uint32_t slot) const { return m_advance[slot]; }
+  uint8_t Baseline(uint32_t slot) const { return m_box[slot * FONT_METRICS_BOX_SIZE]; }
+  uint8_t Offset(uint32_t slot) const { return m_box[slot * FONT_METRICS_BOX_SIZE + 1]; }
+  uint8_t Width(uint32_t slot) const { return m_box[slot * FONT_METRICS_BOX_SIZE + 2]; }
+  uint8_t Height(uint32_t slot) const { return m_box[slot * FONT_METRICS_BOX_SIZE + 3]; }
+
+private:
+  const uint8_t *m_advance;
+  const uint8_t *m_box;
+  uint32_t m_numSlots;
+  };
+
+// a rolling digit strip of the TAPE section
+class FontTapeView
+  {
+public:
+  FontTapeView()
+    {
+    m_entry = NULL;
+    m_bitmap = NULL;
+    }
+
+  FontTapeView(const uint8_t *entry, const uint8_t *bitmap)
+    {
+    m_entry = entry;
+    m_bitmap = bitmap;
+    }
+
+  bool IsValid() const { return m_bitmap != NULL; }
+
+  uint8_t PixelSize() const { return m_entry[0]; }
+  int BitsPerPixel() const { return m_entry[1] > 1 ? m_entry[1] : 1; }
+  uint8_t Width() const { return m_entry[2]; }
+  uint8_t DigitHeight() const { return m_entry[3]; }
+  uint8_t Baseline() const { return m_entry[4]; }
+  // rows in the strip
+  uint32_t Height() const { return DigitHeight() * FONT_TAPE_DIGITS; }
+  uint16_t Stride() const { return FontStride(Width(), BitsPerPixel()); }
+  // first row of a digit, a drum between two digits is a window that
+  // starts part way to the next one
+  uint32_t DigitRow(int digit) const { return digit * DigitHeight(); }
+  const uint8_t *Row(uint32_t row) const { return m_bitmap + row * Stride(); }
+
+  uint8_t Pixel(int col, uint32_t row) const
+    {
+    int bit = col * BitsPerPixel();
+    return (uint8_t)((Row(row)[bit >> 3] >> (8 - BitsPerPixel() - (bit & 7))) & ((1 << BitsPerPixel()) - 1));
+    }
+
+private:
+  const uint8_t *m_entry;
+  const uint8_t *m_bitmap;
+  };
+
+// one pixel size, starting at its record_size
+class FontRecordView
+  {
+public:
+  FontRecordView()
+    {
+    m_record = NULL;
+    m_length = 0;
+    m_offsetSize = 2;
+    }
+
+  // length is what the buffer holds from record, version is FONT_VERSION_
+  FontRecordView(const uint8_t *record, uint32_t length, int version)
+    {
+    m_record = NULL;
+    m_length = 0;
+    m_offsetSize = FontOffsetSize(version);
+
+    if(record == NULL || length < FontRecordHeaderSize(version))
+      return;
+
+    uint32_t recordSize = FontGetBigEndian(record, m_offsetSize);
+    if(recordSize < FontRecordHeaderSize(version) || recordSize > length)
+      return;
+
+    m_record = record;
+    m_length = recordSize;
+    }
+
+  bool IsValid() const { return m_record != NULL; }
+
+  // record_size, the bytes to the next record
+  uint32_t Length() const { return m_length; }
+  uint8_t PixelSize() const { return Field(FONT_RECORD_PIXEL_SIZE); }
+  uint8_t VerticalHeight() const { return Field(FONT_RECORD_HEIGHT); }
+  uint8_t Baseline() const { return Field(FONT_RECORD_BASELINE); }
+  uint8_t NumMaps() const { return Field(FONT_RECORD_NUM_MAPS); }
+  int BitsPerPixel() const { return Field(FONT_RECORD_BPP) > 1 ? Field(FONT_RECORD_BPP) : 1; }
+  uint8_t Flags() const { return Field(FONT_RECORD_FLAGS); }
+  bool HasWideMaps() const { return (Flags() & FONT_RECORD_FLAG_WIDE_MAPS) != 0; }
+  bool HasEncodedGlyphs() const { return (Flags() & FONT_RECORD_FLAG_ENCODED_GLYPHS) != 0; }
+  bool IsRotated() const { return (Flags() & FONT_RECORD_FLAG_ROTATED) != 0; }
+  const uint8_t *Data() const { return m_record; }
+
+  FontCharMapView FirstMap() const
+    {
+    return FontCharMapView(m_record + FONT_RECORD_HEADER_SIZE - 2 + m_offsetSize, m_record + m_length, m_offsetSize,
+      HasWideMaps());
+    }
+
+  // the glyph at an offset from the char maps, not valid if its header
+  // and its bitmap or runs are not all in the record
+  FontGlyphView GlyphAt(uint32_t offset) const
+    {
+    uint32_t headerSize = FONT_GLYPH_HEADER_SIZE + (HasEncodedGlyphs() ? 1 : 0);
+    if(offset == 0 || offset > m_length || m_length - offset < headerSize)
+      return FontGlyphView();
+
+    const glyph_t *glyph = (const glyph_t *)(m_record + offset);
+    uint32_t left = m_length - offset - headerSize;
+    int encoding = HasEncodedGlyphs() ? glyph->pixels[0] : FONT_GLYPH_RAW;
+    if(encoding == FONT_GLYPH_RUNS)
+      {
+      if(!RunsFit(glyph->pixels + 1, glyph->height, left))
+        return FontGlyphView();
+      }
+    else if(encoding != FONT_GLYPH_RAW || (uint32_t) FontStride(glyph->width, BitsPerPixel()) * glyph->height > left)
+      return FontGlyphView();
+
+    return FontGlyphView(glyph, BitsPerPixel(), HasEncodedGlyphs(), IsRotated());
+    }
+
+  // the glyph of a character, not valid if the font does not have it or
+  // a char map before the one that has it is not whole
+  FontGlyphView FindGlyph(uint32_t ch) const
+    {
+    FontCharMapView map = FirstMap();
+    for(uint8_t n = NumMaps(); n > 0 && map.IsValid(); n--, map = map.Next())
+      {
+      if(map.Contains(ch))
+        return GlyphAt(map.GlyphOffset(ch));
+      }
+
+    return FontGlyphView();
+    }
+
+  // slot of a character in the metrics arrays, -1 if no whole map spans it
+  int32_t CharSlot(uint32_t ch) const
+    {
+    uint32_t slot = 0;
+    FontCharMapView map = FirstMap();
+    for(uint8_t n = NumMaps(); n > 0 && map.IsValid(); n--, map = map.Next())
+      {
+      if(map.Contains(ch))
+        return (int32_t)(slot + ch - map.Start());
+
+      slot += map.NumChars();
+      }
+
+    return -1;
+    }
+
+  // the glyph of a character using the lookup table of the file
+  FontGlyphView FindGlyph(uint32_t ch, const FontAccelView &accel) const
+    {
+    if(!accel.IsValid())
+      return FindGlyph(ch);
+
+    uint32_t pos = accel.Position(ch);
+    if(pos == 0 || pos + m_offsetSize > m_length)
+      return FontGlyphView();
+
+    return GlyphAt(FontGetBigEndian(m_record + pos, m_offsetSize));
+    }
+
+private:
+  uint8_t Field(uint32_t field) const { return m_record[m_offsetSize + field]; }
+
+  // true if the runs of the rows of a glyph are in length bytes.  The
+  // first row has no row above to repeat
+  static bool RunsFit(const uint8_t *runs, uint8_t height, uint32_t length)
+    {
+    uint32_t pos = 0;
+    for(uint8_t row = 0; row < height; row++)
+      {
+      if(pos >= length || runs[pos] > FONT_RUNS_REPEAT || (row == 0 && runs[pos] == FONT_RUNS_REPEAT))
+        return false;
+
+      pos += runs[pos] == FONT_RUNS_REPEAT ? 1 : 1 + (runs[pos] << 1);
+      }
+
+    return pos <= length;
+    }
+
+  const uint8_t *m_record;
+  uint32_t m_length;
+  uint32_t m_offsetSize;
+  };
+
+// a record of a CFNT directory
+struct FontDirectoryEntry
+  {
+  uint8_t size;               // pixel size
+  uint8_t codec;              // FONT_CODEC_
+  uint16_t numPages;
+  uint32_t offset;            // from the start of the file
+  uint32_t compressedLength;
+  uint32_t rawLength;
+  };
+
+// a whole font stream
+class FontFileView
+  {
+public:
+  FontFileView()
+    {
+    m_data = NULL;
+    m_length = 0;
+    m_recordsOffset = FONT_HEADER_SIZE;
+    }
+
+  // length is what the buffer holds
+  FontFileView(const uint8_t *data, size_t length)
+    {
+    m_data = NULL;
+    m_length = 0;
+    m_recordsOffset = FONT_HEADER_SIZE;
+
+    if(data == NULL || length < FONT_HEADER_SIZE)
+      return;
+
+    if(memcmp(data, FONT_MAGIC, 4) != 0 && memcmp(data, CFNT_MAGIC, 4) != 0)
+      return;
+
+    m_data = data;
+    m_length = length;
+
+    // an uncompressed stream has to hold all of its records, and the
+    // length of a stream without a directory has to reach past the
+    // sections to where its records start
+    if(!IsCompressed() && FileLength() > length)
+      m_data = NULL;
+    else if(HasDirectory() && FONT_HEADER_SIZE + (size_t) NumFonts() * FONT_DIRECTORY_ENTRY_SIZE > length)
+      m_data = NULL;
+    else if(!WalkSections(NULL, NULL, NULL, &m_recordsOffset))
+      m_data = NULL;
+    else if(!HasDirectory() && FileLength() < m_recordsOffset)
+      m_data = NULL;
+    }
+
+  bool IsValid() const { return m_data != NULL; }
+  bool IsCompressed() const { return memcmp(m_data, CFNT_MAGIC, 4) == 0; }
+
+  // the name is not terminated if it is FONT_NAME_MAX characters
+  const char *Name() const { return (const char *)(m_data + FONT_NAME_OFFSET); }
+  size_t NameLength() const
+    {
+    size_t len = 0;
+    while(len < FONT_NAME_MAX && Name()[len] != 0)
+      len++;
+
+    return len;
+    }
+
+  int Version() const { return m_data[FONT_VERSION_OFFSET] == 0 ? FONT_VERSION_1 : m_data[FONT_VERSION_OFFSET]; }
+  // length of the header and the uncompressed records
+  uint32_t FileLength() const
+    {
+    if(Version() >= FONT_VERSION_2)
+      return FontGetBigEndian(m_data + FONT_LENGTH32_OFFSET, 4);
+
+    return FontGetBigEndian(m_data + FONT_LENGTH_OFFSET, 2);
+    }
+
+  uint8_t NumFonts() const { return m_data[FONT_NUM_FONTS_OFFSET]; }
+  int Codec() const { return m_data[FONT_CODEC_OFFSET]; }
+  uint8_t Flags() const { return m_data[FONT_FLAGS_OFFSET]; }
+  bool HasDirectory() const { return IsCompressed() && (Flags() & FONT_FLAG_DIRECTORY) != 0; }
+  // page size of a directory, 0 if the records are not paged
+  uint32_t PageSize() const
+    {
+    uint8_t shift = m_data[FONT_PAGE_SHIFT_OFFSET];
+    return shift == 0 ? 0 : 1u << shift;
+    }
+
+  const uint8_t *Data() const { return m_data; }
+  size_t Length() const { return m_length; }
+
+  uint8_t NumSections() const { return m_data[FONT_NUM_SECTIONS_OFFSET]; }
+  // offset of the records of a FONT stream, or the compressed stream of a
+  // CFNT stream without a directory
+  uint32_t RecordsOffset() const { return m_recordsOffset; }
+
+  // data of the section with the tag, false if the file does not have one
+  bool FindSection(const char *tag, const uint8_t *&data, uint32_t &length) const
+    {
+    return WalkSections(tag, &data, &length, NULL);
+    }
+
+  // the digit tape of a pixel size, not valid if the file does not have one
+  FontTapeView FindTape(uint8_t pixels) const
+    {
+    const uint8_t *data;
+    uint32_t length;
+    if(!FindSection(FONT_TAPE_TAG, data, length) || length < FONT_TAPE_HEADER_SIZE)
+      return FontTapeView();
+
+    uint8_t numTapes = data[0];
+    if((uint32_t)(FONT_TAPE_HEADER_SIZE + numTapes * FONT_TAPE_ENTRY_SIZE) > length)
+      return FontTapeView();
+
+    for(uint8_t n = 0; n < numTapes; n++)
+      {
+      const uint8_t *entry = data + FONT_TAPE_HEADER_SIZE + n * FONT_TAPE_ENTRY_SIZE;
+      if(entry[0] != pixels)
+        continue;
+
+      FontTapeView tape(entry, data);
+      uint32_t offset = FontGetBigEndian(entry + 8, 4);
+      if(offset > length || (uint64_t) offset + (uint64_t) tape.Stride() * tape.Height() > length)
+        return FontTapeView();
+
+      return FontTapeView(entry, data + offset);
+      }
+
+    return FontTapeView();
+    }
+
+  // the glyph metrics of a pixel size, not valid if the file does not
+  // have them
+  FontMetricsView FindMetrics(uint8_t pixels) const
+    {
+    const uint8_t *data;
+    uint32_t length;
+    if(!FindSection(FONT_METRICS_TAG, data, length) || length < FONT_METRICS_HEADER_SIZE)
+      return FontMetricsView();
+
+    uint8_t numMetrics = data[0];
+    uint32_t numSlots = FontGetBigEndian(data + 4, 4);
+    if((uint32_t)(FONT_METRICS_HEADER_SIZE + numMetrics * FONT_METRICS_ENTRY_SIZE) > length)
+      return FontMetricsView();
+
+    for(uint8_t n = 0; n < numMetrics; n++)
+      {
+      const uint8_t *entry = data + FONT_METRICS_HEADER_SIZE + n * FONT_METRICS_ENTRY_SIZE;
+      if(entry[0] != pixels)
+        continue;
+
+      uint32_t offset = FontGetBigEndian(entry + 4, 4);
+      uint32_t boxStart = FontAlign(numSlots, 4);
+      if((uint64_t) offset + boxStart + (uint64_t) numSlots * FONT_METRICS_BOX_SIZE > length)
+        return FontMetricsView();
+
+      return FontMetricsView(data + offset, data + offset + boxStart, numSlots);
+      }
+
+    return FontMetricsView();
+    }
+
+  // record of a pixel size turned by an angle in degrees, from the ROTN
+  // section.  Angle 0 is the upright record, -1 if the file has none
+  int FindRotated(uint8_t pixels, int angle) const
+    {
+    const uint8_t *data;
+    uint32_t length;
+    if(!FindSection(FONT_ROTATION_TAG, data, length) || length < FONT_ROTATION_HEADER_SIZE)
+      return -1;
+
+    int start = (int) FontGetBigEndian(data, 2);
+    int step = (int) FontGetBigEndian(data + 2, 2);
+    uint8_t numAngles = data[4];
+    uint8_t numSizes = data[5];
+    if(step == 0 || (uint32_t)(FONT_ROTATION_HEADER_SIZE + numSizes * (1 + numAngles)) > length)
+      return -1;
+
+    int turn = ((angle - start) % 360 + 360) % 360;
+    if(turn % step != 0 || turn / step >= numAngles)
+      return -1;
+
+    for(uint8_t n = 0; n < numSizes; n++)
+      {
+      const uint8_t *entry = data + FONT_ROTATION_HEADER_SIZE + n * (1 + numAngles);
+      if(entry[0] == pixels)
+        return entry[1 + turn / step];
+      }
+
+    return -1;
+    }
+
+  // the lookup table of the file, not valid if it does not have one
+  FontAccelView Accel() const
+    {
+    const uint8_t *data;
+    uint32_t length;
+    if(!FindSection(FONT_ACCEL_TAG, data, length))
+      return FontAccelView();
+
+    return FontAccelView(data, length, Version());
+    }
+
+  // records of a FONT stream, in the order they were generated
+  FontRecordView Record(uint8_t fontNum) const
+    {
+    if(IsCompressed() || fontNum >= NumFonts())
+      return FontRecordView();
+
+    uint32_t pos = m_recordsOffset;
+    FontRecordView record(m_data + pos, FileLength() - pos, Version());
+    while(record.IsValid() && fontNum-- > 0)
+      {
+      pos += record.Length();
+      record = FontRecordView(m_data + pos, FileLength() - pos, Version());
+      }
+
+    return record;
+    }
+
+  // the record of a pixel size of a FONT stream
+  FontRecordView FindSize(uint8_t pixels) const
+    {
+    if(IsCompressed())
+      return FontRecordView();
+
+    uint32_t pos = m_recordsOffset;
+    for(uint8_t n = 0; n < NumFonts(); n++)
+      {
+      FontRecordView record(m_data + pos, FileLength() - pos, Version());
+      if(!record.IsValid() || record.PixelSize() == pixels)
+        return record;
+
+      pos += record.Length();
+      }
+
+    return FontRecordView();
+    }
+
+  // directory entry of a CFNT stream with a directory
+  bool DirectoryEntry(uint8_t fontNum, FontDirectoryEntry &entry) const
+    {
+    if(!HasDirectory() || fontNum >= NumFonts())
+      return false;
+
+    const uint8_t *p = m_data + FONT_HEADER_SIZE + fontNum * FONT_DIRECTORY_ENTRY_SIZE;
+    entry.size = p[0];
+    entry.codec = p[1];
+    entry.numPages = (uint16_t) FontGetBigEndian(p + 2, 2);
+    entry.offset = FontGetBigEndian(p + 4, 4);
+    entry.compressedLength = FontGetBigEndian(p + 8, 4);
+    entry.rawLength = FontGetBigEndian(p + 12, 4);
+
+    return (size_t) entry.offset + entry.compressedLength <= m_length;
+    }
+
+private:
+  // walk the sections checking each fits the buffer.  Stops at the tag if
+  // there is one, sets the end of the sections otherwise
+  bool WalkSections(const char *tag, const uint8_t **data, uint32_t *length, uint32_t *end) const
+    {
+    size_t pos = FONT_HEADER_SIZE;
+    if(HasDirectory())
+      pos += (size_t) NumFonts() * FONT_DIRECTORY_ENTRY_SIZE;
+
+    for(uint8_t n = NumSections(); n > 0; n--)
+      {
+      if(pos + FONT_SECTION_HEADER_SIZE > m_length)
+        return false;
+
+      uint32_t len = FontGetBigEndian(m_data + pos + 4, 4);
+      if(pos + FONT_SECTION_HEADER_SIZE + len > m_length)
+        return false;
+
+      if(tag != NULL && memcmp(m_data + pos, tag, 4) == 0)
+        {
+        *data = m_data + pos + FONT_SECTION_HEADER_SIZE;
+        *length = len;
+        return true;
+        }
+
+      pos += FONT_SECTION_HEADER_SIZE + FontAlign(len, 4);
+      }
+
+    if(end != NULL)
+      *end = (uint32_t) pos;
+
+    return tag == NULL;
+    }
+
+  const uint8_t *m_data;
+  size_t m_length;
+  uint32_t m_recordsOffset;
+  };
+
+#endif // !defined(FONTGEN_FONTREADER_H)
@@ -0,0 +1,318 @@
+// FreeTypeRasterizer.cpp : renders TTF/OTF font files with FreeType
+//
+// Used on the linux build hosts where GDI is not available.  The face is
+// loaded from the file named by the font face parameter.  Bold and italic
+// are synthesized when the face itself is not bold or italic, which is what
+// GDI does for an installed face.
+//
+// A font file is read once and shared by every rasterizer that has it
+// open, each worker of each font being built opens its own face on the
+// same memory.
+//
+
+#if defined(FONTGEN_HAVE_FREETYPE)
+
+#include <math.h>
+#include <stdio.h>
+#include <string.h>
+#include <map>
+#include <memory>
+#include <mutex>
+
+#include <ft2build.h>
+#include FT_FREETYPE_H
+#include FT_SYNTHESIS_H
+
+#include "FontBuilder.h"
+#include "FontRasterizer.h"
+
+// FW_SEMIBOLD, anything heavier is rendered bold
+#define BOLD_WEIGHT 600
+
+class FreeTypeRasterizer : public FontRasterizer
+  {
+public:
+  FreeTypeRasterizer(const FontParams &params);
+  ~FreeTypeRasterizer();
+
+  bool Open();
+
+  virtual bool SelectSize(int pixels);
+  virtual const RasterMetrics &Metrics() const { return m_metrics; }
+  virtual bool GlyphExtent(uint32_t ch, int &advance);
+  virtual bool RenderGlyph(uint32_t ch, GlyphBitmap &bitmap);
+  virtual bool RenderRotated(uint32_t ch, int angle, GlyphBitmap &bitmap);
+
+private:
+  bool LoadGlyph(uint32_t ch);
+
+  FontParams m_params;
+  RasterMetrics m_metrics;
+  FT_Library m_library;
+  FT_Face m_face;
+  std::shared_ptr<const std::vector<uint8_t> > m_faceData;
+  bool m_bEmbolden;
+  bool m_bOblique;
+  };
+
+// the contents of a font file, read once while any rasterizer holds it
+static std::shared_ptr<const std::vector<uint8_t> > LoadFaceFile(const std::string &fileName)
+  {
+  static std::mutex lock;
+  static std::map<std::string, std::weak_ptr<const std::vector<uint8_t> > > files;
+
+  std::lock_guard<std::mutex> guard(lock);
+
+  std::shared_ptr<const std::vector<uint8_t> > data = files[fileName].lock();
+  if(data)
+    return data;
+
+  FILE *file = fopen(fileName.c_str(), "rb");
+  if(file == NULL)
+    return data;
+
+  std::vector<uint8_t> *contents = new std::vector<uint8_t>();
+  uint8_t buffer[65536];
+  size_t len;
+  while((len = fread(buffer, 1, sizeof(buffer), file)) > 0)
+    contents->insert(contents->end(), buffer, buffer + len);
+
+  fclose(file);
+
+  data.reset(contents);
+  files[fileName] = data;
+  return data;
+  }
+
+// round a 26.6 fixed point value to pixels
+static inline int Pixels(FT_Pos value)
+  {
+  return (int)((value + 32) >> 6);
+  }
+
+FreeTypeRasterizer::FreeTypeRasterizer(const FontParams &params)
+: m_params(params)
+  {
+  m_library = NULL;
+  m_face = NULL;
+  m_bEmbolden = false;
+  m_bOblique = false;
+  memset(&m_metrics, 0, sizeof(m_metrics));
+  }
+
+FreeTypeRasterizer::~FreeTypeRasterizer()
+  {
+  if(m_face != NULL)
+    FT_Done_Face(m_face);
+
+  if(m_library != NULL)
+    FT_Done_FreeType(m_library);
+  }
+
+bool FreeTypeRasterizer::Open()
+  {
+  if(FT_Init_FreeType(&m_library) != 0)
+    return Fail("Cannot initialize FreeType");
+
+  m_faceData = LoadFaceFile(m_params.fontFace);
+  if(!m_faceData || m_faceData->empty())
+    return Fail("Cannot load the font file");
+
+  if(FT_New_Memory_Face(m_library, &(*m_faceData)[0], (FT_Long) m_faceData->size(), 0, &m_face) != 0)
+    return Fail("Cannot load the font file");
+
+  if(!FT_IS_SCALABLE(m_face))
+    return Fail("The font file is not a scalable font");
+
+  if(FT_Select_Charmap(m_face, FT_ENCODING_UNICODE) != 0)
+    return Fail("The font file has no unicode character map");
+
+  m_bEmbolden = m_params.fontWeight >= BOLD_WEIGHT && (m_face->style_flags & FT_STYLE_FLAG_BOLD) == 0;
+  m_bOblique = m_params.italic && (m_face->style_flags & FT_STYLE_FLAG_ITALIC) == 0;
+
+  return true;
+  }
+
+bool FreeTypeRasterizer::SelectSize(int pixels)
+  {
+  // the requested size is the cell height, the same as a positive
+  // height passed to CreateFont
+  FT_Size_RequestRec req;
+  req.type = FT_SIZE_REQUEST_TYPE_CELL;
+  req.width = 0;
+  req.height = pixels << 6;
+  req.horiResolution = 0;
+  req.vertResolution = 0;
+
+  if(FT_Request_Size(m_face, &req) != 0)
+    return Fail("Cannot select the pixel size");
+
+  const FT_Size_Metrics &sm = m_face->size->metrics;
+
+  m_metrics.ascent = Pixels(sm.ascender);
+  m_metrics.height = m_metrics.ascent + Pixels(-sm.descender);
+  m_metrics.maxCharWidth = Pixels(sm.max_advance);
+
+  return true;
+  }
+
+bool FreeTypeRasterizer::LoadGlyph(uint32_t ch)
+  {
+  FT_UInt index = FT_Get_Char_Index(m_face, ch);
+
+  // a 1 bit font is hinted for monochrome like GDI DEFAULT_QUALITY
+  FT_Int32 target = m_params.bitsPerPixel > 1 ? FT_LOAD_TARGET_NORMAL : FT_LOAD_TARGET_MONO;
+
+  if(FT_Load_Glyph(m_face, index, target) != 0)
+    return Fail("Cannot load the glyph");
+
+  if(m_bOblique)
+    FT_GlyphSlot_Oblique(m_face->glyph);
+
+  if(m_bEmbolden)
+    FT_GlyphSlot_Embolden(m_face->glyph);
+
+  return true;
+  }
+
+bool FreeTypeRasterizer::GlyphExtent(uint32_t ch, int &advance)
+  {
+  if(!LoadGlyph(ch))
+    return false;
+
+  advance = Pixels(m_face->glyph->advance.x);
+  return true;
+  }
+
+bool FreeTypeRasterizer::RenderGlyph(uint32_t ch, GlyphBitmap &bitmap)
+  {
+  if(!LoadGlyph(ch))
+    return false;
+
+  FT_GlyphSlot slot = m_face->glyph;
+
+  FT_Render_Mode mode = m_params.bitsPerPixel > 1 ? FT_RENDER_MODE_NORMAL : FT_RENDER_MODE_MONO;
+
+  if(FT_Render_Glyph(slot, mode) != 0)
+    return Fail("Cannot render the bitmap");
+
+  bitmap.width = Pixels(slot->advance.x);
+  bitmap.height = m_metrics.height;
+  bitmap.coverage.assign(bitmap.width * bitmap.height, 0);
+
+  // copy the rendered glyph into the cell, anything outside the cell is
+  // clipped the same as GDI does
+  const FT_Bitmap &src = slot->bitmap;
+  for(unsigned int row = 0; row < src.rows; row++)
+    {
+    int y = m_metrics.ascent - slot->bitmap_top + (int) row;
+    if(y < 0 || y >= bitmap.height)
+      continue;
+
+    const uint8_t *line = src.buffer + (int) row * src.pitch;
+    for(unsigned int col = 0; col < src.width; col++)
+      {
+      int x = slot->bitmap_left + (int) col;
+      if(x < 0 || x >= bitmap.width)
+        continue;
+
+      uint8_t value;
+      if(src.pixel_mode == FT_PIXEL_MODE_MONO)
+        value = (line[col >> 3] & (0x80 >> (col & 7))) != 0 ? 255 : 0;
+      else
+        value = line[col];
+
+      bitmap.coverage[y * bitmap.width + x] = value;
+      }
+    }
+
+  if(m_params.underline)
+    {
+    FT_Fixed scale = m_face->size->metrics.y_scale;
+    int thickness = Pixels(FT_MulFix(m_face->underline_thickness, scale));
+    if(thickness < 1)
+      thickness = 1;
+
+    // the underline position is the center of the stroke
+    int top = m_metrics.ascent - Pixels(FT_MulFix(m_face->underline_position, scale)) - thickness / 2;
+
+    for(int y = top; y < top + thickness; y++)
+      if(y >= 0 && y < bitmap.height)
+        memset(&bitmap.coverage[y * bitmap.width], 255, bitmap.width);
+    }
+
+  return true;
+  }
+
+bool FreeTypeRasterizer::RenderRotated(uint32_t ch, int angle, GlyphBitmap &bitmap)
+  {
+  // the underline is drawn into the upright cell and the slant has to be
+  // applied before the turn, so those are rotated from the upright cell
+  if(m_params.underline || m_bOblique)
+    return FontRasterizer::RenderRotated(ch, angle, bitmap);
+
+  if(!GlyphExtent(ch, bitmap.advance))
+    return false;
+
+  // the outline is turned as it is loaded, y is up in FreeType
+  double rad = angle * 3.14159265358979323846 / 180;
+  FT_Matrix matrix;
+  matrix.xx = (FT_Fixed)(cos(rad) * 0x10000);
+  matrix.xy = (FT_Fixed)(-sin(rad) * 0x10000);
+  matrix.yx = (FT_Fixed)(sin(rad) * 0x10000);
+  matrix.yy = matrix.xx;
+
+  FT_Set_Transform(m_face, &matrix, NULL);
+  bool loaded = LoadGlyph(ch);
+  FT_Set_Transform(m_face, NULL, NULL);
+
+  if(!loaded)
+    return false;
+
+  FT_GlyphSlot slot = m_face->glyph;
+
+  FT_Render_Mode mode = m_params.bitsPerPixel > 1 ? FT_RENDER_MODE_NORMAL : FT_RENDER_MODE_MONO;
+
+  if(FT_Render_Glyph(slot, mode) != 0)
+    return Fail("Cannot render the bitmap");
+
+  const FT_Bitmap &src = slot->bitmap;
+  bitmap.width = (int) src.width;
+  bitmap.height = (int) src.rows;
+  bitmap.originX = -slot->bitmap_left;
+  bitmap.originY = slot->bitmap_top;
+  bitmap.coverage.assign(bitmap.width * bitmap.height, 0);
+
+  for(unsigned int row = 0; row < src.rows; row++)
+    {
+    const uint8_t *line = src.buffer + (int) row * src.pitch;
+    for(unsigned int col = 0; col < src.width; col++)
+      {
+      uint8_t value;
+      if(src.pixel_mode == FT_PIXEL_MODE_MONO)
+        value = (line[col >> 3] & (0x80 >> (col & 7))) != 0 ? 255 : 0;
+      else
+        value = line[col];
+
+      bitmap.coverage[row * bitmap.width + col] = value;
+      }
+    }
+
+  return true;
+  }
+
+FontRasterizer *CreateFreeTypeRasterizer(const FontParams &params, std::string &error)
+  {
+  FreeTypeRasterizer *rasterizer = new FreeTypeRasterizer(params);
+
+  if(!rasterizer->Open())
+    {
+    error = rasterizer->Error();
+    delete rasterizer;
+    return NULL;
+    }
+
+  return rasterizer;
+  }
+
+#endif // defined(FONTGEN_HAVE_FREETYPE)
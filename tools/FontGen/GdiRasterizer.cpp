@@ -0,0 +1,436 @@
+// GdiRasterizer.cpp : renders installed faces with GDI
+//
+// A size's characters are drawn as a strip into a DIB section with as few
+// ExtTextOut calls as possible.  The cells are then read straight from the
+// section memory.  A 1 bit per pixel font uses a monochrome section whose
+// cells are trimmed and packed a word at a time, a deeper font is drawn
+// antialiased into a 32 bit section and read as coverage.
+//
+
+#if defined(_WIN32)
+
+#include <windows.h>
+#include <intrin.h>
+#include <string.h>
+
+#include "FontBuilder.h"
+#include "FontRasterizer.h"
+
+// widest strip drawn with one ExtTextOut call
+#define MAX_STRIP_WIDTH 8192
+
+// UTF-16 of a code point, returns the number of units
+static int PutUtf16(uint32_t ch, WCHAR *str)
+  {
+  if(ch < 0x10000)
+    {
+    str[0] = (WCHAR) ch;
+    return 1;
+    }
+
+  ch -= 0x10000;
+  str[0] = (WCHAR)(0xD800 | (ch >> 10));
+  str[1] = (WCHAR)(0xDC00 | (ch & 0x3FF));
+  return 2;
+  }
+
+// 32 pixels of a monochrome row from bit on, the leftmost in the top
+// bit.  Bytes past the end of the row are blank
+static inline uint32_t LoadBits(const uint8_t *line, int stride, int bit)
+  {
+  int at = bit >> 3;
+  uint64_t word = 0;
+  for(int i = 0; i < 5; i++)
+    word = (word << 8) | (at + i < stride ? line[at + i] : 0);
+
+  return (uint32_t)(word >> (8 - (bit & 7)));
+  }
+
+// 32 pixels of a cell row from col on, pixels past the cell are blank
+static inline uint32_t CellBits(const uint8_t *line, int stride, int cellX, int width, int col)
+  {
+  uint32_t word = LoadBits(line, stride, cellX + col);
+  if(width - col < 32)
+    word &= 0xFFFFFFFFu << (32 - (width - col));
+
+  return word;
+  }
+
+// trim a cell of a monochrome strip to its ink and pack it.  The rows are
+// ORed together a word at a time so the columns are only searched once
+static void PackStripCell(const uint8_t *strip, int stride, int cellX, GlyphBitmap &bitmap,
+  std::vector<uint32_t> &columns)
+  {
+  int words = (bitmap.width + 31) >> 5;
+  columns.assign(words, 0);
+
+  bitmap.packed = true;
+  bitmap.coverage.clear();
+  bitmap.inkTop = -1;
+  int bottom = -1;
+  for(int row = 0; row < bitmap.height; row++)
+    {
+    const uint8_t *line = strip + row * stride;
+    uint32_t any = 0;
+    for(int w = 0; w < words; w++)
+      {
+      uint32_t word = CellBits(line, stride, cellX, bitmap.width, w << 5);
+      columns[w] |= word;
+      any |= word;
+      }
+
+    if(any != 0)
+      {
+      if(bitmap.inkTop < 0)
+        bitmap.inkTop = row;
+      bottom = row;
+      }
+    }
+
+  if(bitmap.inkTop < 0)
+    {
+    bitmap.inkLeft = 0;
+    bitmap.inkTop = 0;
+    bitmap.inkWidth = 0;
+    bitmap.inkHeight = 0;
+    bitmap.bits.clear();
+    return;
+    }
+
+  int first = 0;
+  while(columns[first] == 0)
+    first++;
+
+  int last = words - 1;
+  while(columns[last] == 0)
+    last--;
+
+  unsigned long bit;
+  _BitScanReverse(&bit, columns[first]);
+  bitmap.inkLeft = (first << 5) + 31 - (int) bit;
+  _BitScanForward(&bit, columns[last]);
+  int right = (last << 5) + 31 - (int) bit;
+
+  bitmap.inkWidth = right - bitmap.inkLeft + 1;
+  bitmap.inkHeight = bottom - bitmap.inkTop + 1;
+
+  // the ink rows are copied a word at a time from the left of the ink
+  int rowBytes = (bitmap.inkWidth + 7) >> 3;
+  bitmap.bits.assign(rowBytes * bitmap.inkHeight, 0);
+  for(int row = 0; row < bitmap.inkHeight; row++)
+    {
+    const uint8_t *line = strip + (row + bitmap.inkTop) * stride;
+    uint8_t *out = &bitmap.bits[row * rowBytes];
+    for(int col = 0; col < bitmap.inkWidth; col += 32)
+      {
+      uint32_t word = CellBits(line, stride, cellX + bitmap.inkLeft, bitmap.inkWidth, col);
+      for(int b = 0; b < 4 && (col >> 3) + b < rowBytes; b++)
+        out[(col >> 3) + b] = (uint8_t)(word >> (24 - (b << 3)));
+      }
+    }
+  }
+
+class GdiRasterizer : public FontRasterizer
+  {
+public:
+  GdiRasterizer(const FontParams &params);
+  ~GdiRasterizer();
+
+  bool Open();
+
+  virtual bool SelectSize(int pixels);
+  virtual const RasterMetrics &Metrics() const { return m_metrics; }
+  virtual bool GlyphExtent(uint32_t ch, int &advance);
+  virtual bool RenderGlyph(uint32_t ch, GlyphBitmap &bitmap);
+  virtual bool RenderGlyphs(const uint32_t *chars, size_t count, std::vector<GlyphBitmap> &bitmaps);
+
+private:
+  void ReleaseSize();
+  void ReleaseStrip();
+  bool CreateStrip(int width);
+  bool RenderStrip(const uint32_t *chars, size_t count, GlyphBitmap *bitmaps, bool pack);
+
+  FontParams m_params;
+  RasterMetrics m_metrics;
+  HDC m_dc;
+  HFONT m_font;
+  HGDIOBJ m_oldFont;
+  // the strip the glyphs are rendered into
+  HBITMAP m_strip;
+  HGDIOBJ m_oldStrip;
+  uint8_t *m_stripBits;
+  int m_stripWidth;
+  int m_stripStride;
+  bool m_bAntialias;          // 32 bit strip, coverage is the green channel
+  std::vector<uint32_t> m_columns;    // ink of each column word of a cell
+  };
+
+GdiRasterizer::GdiRasterizer(const FontParams &params)
+: m_params(params)
+  {
+  m_dc = NULL;
+  m_font = NULL;
+  m_oldFont = NULL;
+  m_strip = NULL;
+  m_oldStrip = NULL;
+  m_stripBits = NULL;
+  m_stripWidth = 0;
+  m_stripStride = 0;
+  m_bAntialias = params.bitsPerPixel > 1;
+  memset(&m_metrics, 0, sizeof(m_metrics));
+  }
+
+GdiRasterizer::~GdiRasterizer()
+  {
+  ReleaseSize();
+
+  if(m_dc != NULL)
+    DeleteDC(m_dc);
+  }
+
+bool GdiRasterizer::Open()
+  {
+  HDC sdc = GetDC(NULL);
+  m_dc = CreateCompatibleDC(sdc);
+  ReleaseDC(NULL, sdc);
+
+  if(m_dc == NULL)
+    return Fail("Cannot create a render context");
+
+  return true;
+  }
+
+void GdiRasterizer::ReleaseStrip()
+  {
+  if(m_oldStrip != NULL)
+    SelectObject(m_dc, m_oldStrip);
+
+  if(m_strip != NULL)
+    DeleteObject(m_strip);
+
+  m_strip = NULL;
+  m_oldStrip = NULL;
+  m_stripBits = NULL;
+  m_stripWidth = 0;
+  m_stripStride = 0;
+  }
+
+void GdiRasterizer::ReleaseSize()
+  {
+  ReleaseStrip();
+
+  if(m_oldFont != NULL)
+    SelectObject(m_dc, m_oldFont);
+
+  if(m_font != NULL)
+    DeleteObject(m_font);
+
+  m_font = NULL;
+  m_oldFont = NULL;
+  }
+
+// the strip is a top-down 1bpp dib so text is rendered the same as into
+// the monochrome bitmap that CreateCompatibleBitmap makes for a memory dc.
+// Antialiased text needs a 32bpp dib, white on black gives gray levels
+bool GdiRasterizer::CreateStrip(int width)
+  {
+  if(m_strip != NULL && width <= m_stripWidth)
+    return true;
+
+  ReleaseStrip();
+
+  struct
+    {
+    BITMAPINFOHEADER bmiHeader;
+    RGBQUAD bmiColors[2];
+    } bmi;
+
+  memset(&bmi, 0, sizeof(bmi));
+  bmi.bmiHeader.biSize = sizeof(BITMAPINFOHEADER);
+  bmi.bmiHeader.biWidth = width;
+  bmi.bmiHeader.biHeight = -m_metrics.height;
+  bmi.bmiHeader.biPlanes = 1;
+  bmi.bmiHeader.biBitCount = m_bAntialias ? 32 : 1;
+  bmi.bmiHeader.biCompression = BI_RGB;
+  bmi.bmiColors[1].rgbRed = 0xFF;
+  bmi.bmiColors[1].rgbGreen = 0xFF;
+  bmi.bmiColors[1].rgbBlue = 0xFF;
+
+  void *bits = NULL;
+  m_strip = CreateDIBSection(m_dc, (BITMAPINFO *) &bmi, DIB_RGB_COLORS, &bits, NULL, 0);
+  if(m_strip == NULL)
+    return Fail("Cannot create the glyph strip");
+
+  m_oldStrip = SelectObject(m_dc, m_strip);
+  m_stripBits = (uint8_t *) bits;
+  m_stripWidth = width;
+  // dib rows are 32 bit aligned
+  if(m_bAntialias)
+    m_stripStride = width << 2;
+  else
+    m_stripStride = ((width + 31) >> 5) << 2;
+
+  // white is the foreground color
+  SetTextColor(m_dc, 0xFFFFFF);
+  SetBkMode(m_dc, TRANSPARENT);
+
+  return true;
+  }
+
+bool GdiRasterizer::SelectSize(int pixels)
+  {
+  ReleaseSize();
+
+  m_font = CreateFontA(pixels, 0, 0, 0, m_params.fontWeight, m_params.italic, m_params.underline,
+    0, 0, OUT_DEFAULT_PRECIS, CLIP_DEFAULT_PRECIS, m_bAntialias ? ANTIALIASED_QUALITY : DEFAULT_QUALITY, FF_DONTCARE | DEFAULT_PITCH,
+    m_params.fontFace.c_str());
+
+  if(m_font == NULL)
+    return Fail("Cannot create the font");
+
+  m_oldFont = SelectObject(m_dc, m_font);
+
+  OUTLINETEXTMETRICA otm;
+  if(GetOutlineTextMetricsA(m_dc, sizeof(OUTLINETEXTMETRICA), &otm) == 0)
+    return Fail("Cannot get the font metrics");
+
+  m_metrics.height = otm.otmTextMetrics.tmHeight;
+  m_metrics.ascent = otm.otmTextMetrics.tmAscent;
+  m_metrics.maxCharWidth = otm.otmTextMetrics.tmMaxCharWidth;
+
+  return true;
+  }
+
+bool GdiRasterizer::GlyphExtent(uint32_t ch, int &advance)
+  {
+  WCHAR str[2];
+  SIZE w;
+  if(!GetTextExtentPoint32W(m_dc, str, PutUtf16(ch, str), &w))
+    return Fail("Cannot measure the glyph");
+
+  advance = w.cx;
+  return true;
+  }
+
+bool GdiRasterizer::RenderGlyph(uint32_t ch, GlyphBitmap &bitmap)
+  {
+  if(!GlyphExtent(ch, bitmap.width))
+    return false;
+
+  return RenderStrip(&ch, 1, &bitmap, false);
+  }
+
+bool GdiRasterizer::RenderGlyphs(const uint32_t *chars, size_t count, std::vector<GlyphBitmap> &bitmaps)
+  {
+  bitmaps.resize(count);
+
+  // each cell is followed by a gap as wide as the widest glyph so ink
+  // that overhangs a cell is not read as part of the next one
+  int pitch = 0;
+  size_t first = 0;
+  for(size_t i = 0; i < count; i++)
+    {
+    if(!GlyphExtent(chars[i], bitmaps[i].width))
+      return false;
+
+    int cell = bitmaps[i].width + m_metrics.maxCharWidth;
+    if(pitch > 0 && pitch + cell > MAX_STRIP_WIDTH)
+      {
+      if(!RenderStrip(chars + first, i - first, &bitmaps[first], !m_bAntialias))
+        return false;
+
+      first = i;
+      pitch = 0;
+      }
+
+    pitch += cell;
+    }
+
+  if(first < count)
+    return RenderStrip(chars + first, count - first, &bitmaps[first], !m_bAntialias);
+
+  return true;
+  }
+
+// draw a run of characters into the strip and read back their cells, as
+// packed ink if pack is set or else as coverage
+bool GdiRasterizer::RenderStrip(const uint32_t *chars, size_t count, GlyphBitmap *bitmaps, bool pack)
+  {
+  // a character outside the BMP takes two UTF-16 units, the second of
+  // which does not advance
+  std::vector<WCHAR> str(count * 2);
+  std::vector<INT> dx(count * 2);
+  std::vector<int> cellX(count);
+
+  // the advance of each glyph is already in the bitmap width
+  int x = 0;
+  size_t units = 0;
+  for(size_t i = 0; i < count; i++)
+    {
+    bitmaps[i].height = m_metrics.height;
+    int len = PutUtf16(chars[i], &str[units]);
+    cellX[i] = x;
+    dx[units] = bitmaps[i].width + m_metrics.maxCharWidth;
+    if(len > 1)
+      dx[units + 1] = 0;
+
+    x += dx[units];
+    units += len;
+    }
+
+  if(!CreateStrip(x))
+    return false;
+
+  memset(m_stripBits, 0, m_stripStride * m_metrics.height);
+
+  if (!ExtTextOutW(m_dc, 0, 0, 0, NULL, &str[0], (UINT) units, &dx[0]))
+    return Fail("Cannot render the bitmap");
+
+  // make sure GDI has finished with the section memory
+  GdiFlush();
+
+  for(size_t i = 0; i < count; i++)
+    {
+    GlyphBitmap &bitmap = bitmaps[i];
+    if(pack)
+      {
+      PackStripCell(m_stripBits, m_stripStride, cellX[i], bitmap, m_columns);
+      continue;
+      }
+
+    bitmap.packed = false;
+    bitmap.coverage.resize(bitmap.width * bitmap.height);
+
+    uint8_t *cov = bitmap.coverage.empty() ? NULL : &bitmap.coverage[0];
+    for(int row = 0; row < bitmap.height; row++)
+      {
+      const uint8_t *line = m_stripBits + row * m_stripStride;
+      for(int col = 0; col < bitmap.width; col++)
+        {
+        int bit = cellX[i] + col;
+        if(m_bAntialias)
+          *cov++ = line[(bit << 2) + 1];
+        else
+          *cov++ = (line[bit >> 3] & (0x80 >> (bit & 7))) != 0 ? 255 : 0;
+        }
+      }
+    }
+
+  return true;
+  }
+
+FontRasterizer *CreateGdiRasterizer(const FontParams &params, std::string &error)
+  {
+  GdiRasterizer *rasterizer = new GdiRasterizer(params);
+
+  if(!rasterizer->Open())
+    {
+    error = rasterizer->Error();
+    delete rasterizer;
+    return NULL;
+    }
+
+  return rasterizer;
+  }
+
+#endif // defined(_WIN32)
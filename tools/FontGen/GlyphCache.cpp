@@ -0,0 +1,279 @@
+// GlyphCache.cpp : on-disk cache of rendered glyphs
+//
+// uint8_t magic[4]                // "FGC1"
+// uint16_t key_length
+// char key[key_length]            // checked so a hash collision misses
+// uint32_t height, ascent, max_char_width
+// uint32_t num_glyphs
+// -- then num_glyphs of --
+// uint32_t ch
+// uint16_t length
+// uint8_t glyph[length]
+//
+// Values are big endian like the font.  A file is written under a
+// temporary name and renamed so a build running alongside never reads
+// half of one.
+//
+
+#include <stdio.h>
+#include <string.h>
+#include <errno.h>
+#if defined(_WIN32)
+#include <windows.h>
+#include <direct.h>
+#include <process.h>
+#else
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#include "FontBuilder.h"
+#include "GlyphCache.h"
+
+#define GLYPH_CACHE_MAGIC       "FGC1"
+
+// changes to how glyphs are built that the params do not show
+#define GLYPH_CACHE_VERSION     1
+
+// FNV-1a 64 bit
+#define FNV_PRIME               1099511628211ULL
+
+uint64_t GlyphCache::Hash(const void *data, size_t len, uint64_t hash)
+  {
+  const uint8_t *p = (const uint8_t *) data;
+  for(size_t i = 0; i < len; i++)
+    {
+    hash ^= p[i];
+    hash *= FNV_PRIME;
+    }
+
+  return hash;
+  }
+
+// hash of the contents of a font file, 0 for an installed face
+static uint64_t HashFile(const std::string &fileName)
+  {
+  FILE *file = fopen(fileName.c_str(), "rb");
+  if(file == NULL)
+    return 0;
+
+  uint64_t hash = GlyphCache::Hash(NULL, 0);
+  uint8_t buffer[65536];
+  size_t len;
+  while((len = fread(buffer, 1, sizeof(buffer), file)) > 0)
+    hash = GlyphCache::Hash(buffer, len, hash);
+
+  fclose(file);
+  return hash;
+  }
+
+#if defined(_WIN32)
+// hash of the data of the installed face GDI selects for the params, so a
+// face that is updated or replaced by another with its name misses.  0 if
+// GDI cannot give the data, a raster or device font
+static uint64_t HashInstalledFace(const FontParams &params)
+  {
+  HDC dc = CreateCompatibleDC(NULL);
+  if(dc == NULL)
+    return 0;
+
+  HFONT font = CreateFontA(0, 0, 0, 0, params.fontWeight, params.italic, params.underline, 0, 0, OUT_DEFAULT_PRECIS,
+    CLIP_DEFAULT_PRECIS, DEFAULT_QUALITY, FF_DONTCARE | DEFAULT_PITCH, params.fontFace.c_str());
+
+  uint64_t hash = 0;
+  if(font != NULL)
+    {
+    HGDIOBJ oldFont = SelectObject(dc, font);
+
+    // the whole collection of a face in a .ttc, else the face's file
+    DWORD table = 0x66637474;   // 'ttcf'
+    DWORD size = GetFontData(dc, table, 0, NULL, 0);
+    if(size == GDI_ERROR)
+      {
+      table = 0;
+      size = GetFontData(dc, table, 0, NULL, 0);
+      }
+
+    if(size != GDI_ERROR && size > 0)
+      {
+      std::vector<uint8_t> data(size);
+      if(GetFontData(dc, table, 0, &data[0], size) == size)
+        hash = GlyphCache::Hash(&data[0], size);
+      }
+
+    SelectObject(dc, oldFont);
+    DeleteObject(font);
+    }
+
+  DeleteDC(dc);
+  return hash;
+  }
+#endif
+
+static void PutValue(std::vector<uint8_t> &buffer, uint32_t value, uint32_t numBytes)
+  {
+  while(numBytes-- > 0)
+    buffer.push_back((uint8_t)(value >> (numBytes << 3)));
+  }
+
+static uint32_t GetValue(const uint8_t *&p, uint32_t numBytes)
+  {
+  uint32_t value = 0;
+  while(numBytes-- > 0)
+    value = (value << 8) | *p++;
+
+  return value;
+  }
+
+static bool MakeDirectory(const std::string &dir)
+  {
+#if defined(_WIN32)
+  return _mkdir(dir.c_str()) == 0 || errno == EEXIST;
+#else
+  return mkdir(dir.c_str(), 0777) == 0 || errno == EEXIST;
+#endif
+  }
+
+GlyphCache::GlyphCache(const std::string &dir, const FontParams &params)
+: m_dir(dir)
+  {
+  m_faceHash = HashFile(params.fontFace);
+#if defined(_WIN32)
+  if(m_faceHash == 0)
+    m_faceHash = HashInstalledFace(params);
+#endif
+
+  char buf[256];
+  snprintf(buf, sizeof(buf), "v%d|%016llx|%ld|%d|%d|%d|%d|%d", GLYPH_CACHE_VERSION,
+    (unsigned long long) m_faceHash, params.fontWeight, params.italic, params.underline,
+    params.bitsPerPixel, params.rasterizer, params.runLengthGlyphs);
+
+  m_key = params.fontFace + "|" + buf;
+  }
+
+std::string GlyphCache::RecordKey(int pixels, int angle) const
+  {
+  char buf[32];
+  snprintf(buf, sizeof(buf), "|%d|%d", pixels, angle);
+  return m_key + buf;
+  }
+
+std::string GlyphCache::RecordPath(const std::string &key) const
+  {
+  char name[32];
+  snprintf(name, sizeof(name), "%016llx.fgc", (unsigned long long) Hash(key.data(), key.length()));
+  return m_dir + "/" + name;
+  }
+
+bool GlyphCache::Load(int pixels, int angle, CachedRecord &record) const
+  {
+  std::string key = RecordKey(pixels, angle);
+
+  FILE *file = fopen(RecordPath(key).c_str(), "rb");
+  if(file == NULL)
+    return false;
+
+  std::vector<uint8_t> data;
+  uint8_t buffer[65536];
+  size_t len;
+  while((len = fread(buffer, 1, sizeof(buffer), file)) > 0)
+    data.insert(data.end(), buffer, buffer + len);
+
+  fclose(file);
+
+  record.glyphs.clear();
+
+  // anything that does not read back is a miss, the record is rendered
+  // and the file written again
+  size_t headerSize = 4 + 2 + key.length() + 16;
+  if(data.size() < headerSize || memcmp(&data[0], GLYPH_CACHE_MAGIC, 4) != 0)
+    return false;
+
+  const uint8_t *p = &data[4];
+  if(GetValue(p, 2) != key.length() || memcmp(p, key.data(), key.length()) != 0)
+    return false;
+
+  p += key.length();
+  record.metrics.height = (int) GetValue(p, 4);
+  record.metrics.ascent = (int) GetValue(p, 4);
+  record.metrics.maxCharWidth = (int) GetValue(p, 4);
+  uint32_t numGlyphs = GetValue(p, 4);
+
+  const uint8_t *end = &data[0] + data.size();
+  for(uint32_t n = 0; n < numGlyphs; n++)
+    {
+    if(end - p < 6)
+      break;
+
+    uint32_t ch = GetValue(p, 4);
+    uint32_t length = GetValue(p, 2);
+    if((uint32_t)(end - p) < length)
+      break;
+
+    record.glyphs[ch].assign(p, p + length);
+    p += length;
+    }
+
+  if(record.glyphs.size() != numGlyphs)
+    {
+    record.glyphs.clear();
+    return false;
+    }
+
+  return true;
+  }
+
+bool GlyphCache::Store(int pixels, int angle, const CachedRecord &record)
+  {
+  std::string key = RecordKey(pixels, angle);
+
+  std::vector<uint8_t> data(GLYPH_CACHE_MAGIC, GLYPH_CACHE_MAGIC + 4);
+  PutValue(data, (uint32_t) key.length(), 2);
+  data.insert(data.end(), key.begin(), key.end());
+  PutValue(data, (uint32_t) record.metrics.height, 4);
+  PutValue(data, (uint32_t) record.metrics.ascent, 4);
+  PutValue(data, (uint32_t) record.metrics.maxCharWidth, 4);
+  PutValue(data, (uint32_t) record.glyphs.size(), 4);
+
+  std::map<uint32_t, std::vector<uint8_t> >::const_iterator it;
+  for(it = record.glyphs.begin(); it != record.glyphs.end(); ++it)
+    {
+    PutValue(data, it->first, 4);
+    PutValue(data, (uint32_t) it->second.size(), 2);
+    data.insert(data.end(), it->second.begin(), it->second.end());
+    }
+
+  if(!MakeDirectory(m_dir))
+    return Fail("Cannot create the glyph cache directory");
+
+  std::string path = RecordPath(key);
+  char suffix[32];
+#if defined(_WIN32)
+  snprintf(suffix, sizeof(suffix), ".%d.tmp", _getpid());
+#else
+  snprintf(suffix, sizeof(suffix), ".%d.tmp", (int) getpid());
+#endif
+  std::string temp = path + suffix;
+
+  FILE *file = fopen(temp.c_str(), "wb");
+  if(file == NULL)
+    return Fail("Cannot write the glyph cache");
+
+  bool written = fwrite(&data[0], 1, data.size(), file) == data.size();
+  written = fclose(file) == 0 && written;
+
+  // rename does not replace a file on Windows
+  if(written && rename(temp.c_str(), path.c_str()) != 0)
+    {
+    remove(path.c_str());
+    written = rename(temp.c_str(), path.c_str()) == 0;
+    }
+
+  if(!written)
+    {
+    remove(temp.c_str());
+    return Fail("Cannot write the glyph cache");
+    }
+
+  return true;
+  }
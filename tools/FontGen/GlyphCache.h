@@ -0,0 +1,72 @@
+// GlyphCache.h : on-disk cache of rendered glyphs
+//
+// A cache file holds the glyphs of one record: a face file, its rendering
+// params, a pixel size and an angle.  The file is named by a hash of all
+// of them, and the font file is hashed by its contents so an edited font
+// misses.  An installed face is hashed by the data GDI gives for it, a
+// face that cannot be hashed is not cached.  A build loads the glyphs it
+// can, renders only the characters that are missing and stores the
+// record back with them added.
+//
+
+#if !defined(FONTGEN_GLYPHCACHE_H)
+#define FONTGEN_GLYPHCACHE_H
+
+#if _MSC_VER > 1000
+#pragma once
+#endif // _MSC_VER > 1000
+
+#include <stdint.h>
+#include <map>
+#include <string>
+#include <vector>
+
+#include "FontRasterizer.h"
+
+struct FontParams;
+
+// the cached glyphs of one record, the glyph record bytes of each code
+// point
+struct CachedRecord
+  {
+  RasterMetrics metrics;
+  std::map<uint32_t, std::vector<uint8_t> > glyphs;
+  };
+
+class GlyphCache
+  {
+public:
+  // cache the glyphs rendered with the params in a directory
+  GlyphCache(const std::string &dir, const FontParams &params);
+
+  // false if the face's data could not be hashed, a cache of it could
+  // outlive a change to the face
+  bool IsValid() const { return m_faceHash != 0; }
+
+  // the cached glyphs of a pixel size and angle, false if there are none
+  bool Load(int pixels, int angle, CachedRecord &record) const;
+  // replace the cached glyphs of a pixel size and angle
+  bool Store(int pixels, int angle, const CachedRecord &record);
+
+  const std::string &Error() const { return m_strError; }
+
+  // FNV-1a hash of a block
+  static uint64_t Hash(const void *data, size_t len, uint64_t hash = 14695981039346656037ULL);
+
+private:
+  bool Fail(const char *msg)
+    {
+    m_strError = msg;
+    return false;
+    }
+
+  std::string RecordKey(int pixels, int angle) const;
+  std::string RecordPath(const std::string &key) const;
+
+  std::string m_dir;
+  uint64_t m_faceHash;        // the contents of the face, 0 if unknown
+  std::string m_key;          // the face and everything that changes how it renders
+  std::string m_strError;
+  };
+
+#endif // !defined(FONTGEN_GLYPHCACHE_H)
@@ -0,0 +1,51 @@
+// WorkerPool.cpp : runs independent jobs on a set of threads
+//
+
+#include <atomic>
+#include <thread>
+#include <vector>
+
+#include "WorkerPool.h"
+
+int WorkerPool::Threads(int requested)
+  {
+  if(requested > 0)
+    return requested;
+
+  int processors = (int) std::thread::hardware_concurrency();
+  return processors > 0 ? processors : 1;
+  }
+
+void WorkerPool::Run(size_t count, int threads, const std::function<void(size_t item, int worker)> &job)
+  {
+  if((size_t) threads > count)
+    threads = (int) count;
+
+  // nothing to share, run on the calling thread
+  if(threads <= 1)
+    {
+    for(size_t item = 0; item < count; item++)
+      job(item, 0);
+
+    return;
+    }
+
+  std::atomic<size_t> next(0);
+
+  auto worker = [&](int index)
+    {
+    size_t item;
+    while((item = next++) < count)
+      job(item, index);
+    };
+
+  // the calling thread is worker 0
+  std::vector<std::thread> pool;
+  for(int index = 1; index < threads; index++)
+    pool.push_back(std::thread(worker, index));
+
+  worker(0);
+
+  for(size_t i = 0; i < pool.size(); i++)
+    pool[i].join();
+  }
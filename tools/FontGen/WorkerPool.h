@@ -0,0 +1,27 @@
+// WorkerPool.h : runs independent jobs on a set of threads
+//
+
+#if !defined(FONTGEN_WORKERPOOL_H)
+#define FONTGEN_WORKERPOOL_H
+
+#if _MSC_VER > 1000
+#pragma once
+#endif // _MSC_VER > 1000
+
+#include <stddef.h>
+#include <functional>
+
+class WorkerPool
+  {
+public:
+  // threads to use when threads are requested, 0 is one per processor
+  static int Threads(int requested);
+
+  // call job(item, worker) once for each item in [0, count).  Items are
+  // handed out in order but may finish in any order.  worker is the index
+  // of the thread running the item, always less than threads, so a job can
+  // keep state for each thread.  Returns when every item is done
+  static void Run(size_t count, int threads, const std::function<void(size_t item, int worker)> &job);
+  };
+
+#endif // !defined(FONTGEN_WORKERPOOL_H)
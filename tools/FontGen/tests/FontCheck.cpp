@@ -0,0 +1,529 @@
+// FontCheck.cpp : golden output check of the font builder
+//
+// Builds a set of fonts that cover the output types and format options
+// from glyphs drawn by a synthetic rasterizer, so the output depends only
+// on the builder and not on the installed faces or the FreeType version.
+// Each font is compared byte for byte with its reference file in the
+// golden directory and read back with VerifyFontFile.  The character set
+// syntax is checked first, the reader is given cut short records and
+// glyphs too large for a record have to be refused.
+//
+//   FontCheck <golden dir>            check every case
+//   FontCheck --update <golden dir>   rewrite the reference files after an
+//                                     intended format change
+//
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <string>
+#include <vector>
+
+#include "../FontBuilder.h"
+#include "../FontCodec.h"
+#include "../FontRasterizer.h"
+#include "../FontReader.h"
+
+// glyphs made from the character code and the pixel size.  '0' draws the
+// same glyph as 'O' so the records have shared glyphs.  A packed
+// rasterizer delivers batches as packed cells, the way GDI does at 1 bit
+// per pixel, which must build the same font
+class SyntheticRasterizer : public FontRasterizer
+  {
+public:
+  SyntheticRasterizer(bool packed)
+    {
+    m_bPacked = packed;
+    m_pixels = 0;
+    memset(&m_metrics, 0, sizeof(m_metrics));
+    }
+
+  virtual bool SelectSize(int pixels)
+    {
+    m_pixels = pixels;
+    m_metrics.height = pixels + pixels / 4;
+    m_metrics.ascent = pixels;
+    m_metrics.maxCharWidth = 4 + pixels / 2;
+    return true;
+    }
+
+  virtual const RasterMetrics &Metrics() const { return m_metrics; }
+
+  virtual bool GlyphExtent(uint32_t ch, int &advance)
+    {
+    advance = 2 + m_pixels / 2 + (int)(ch % 3);
+    return true;
+    }
+
+  virtual bool RenderGlyph(uint32_t ch, GlyphBitmap &bitmap)
+    {
+    if(ch == '0')
+      ch = 'O';
+
+    GlyphExtent(ch, bitmap.width);
+    bitmap.height = m_metrics.height;
+    bitmap.coverage.assign(bitmap.width * bitmap.height, 0);
+    bitmap.originX = 0;
+    bitmap.originY = 0;
+    bitmap.advance = bitmap.width;
+
+    if(ch == ' ')
+      return true;
+
+    // a box from the cap height to the baseline, or below it for the
+    // characters with descenders, filled with a pattern of the code
+    int top = m_pixels / 4 + (int)(ch % 4);
+    int bottom = strchr("gjpqy", (int) ch) != NULL ? m_metrics.height : m_metrics.ascent;
+    for(int row = top; row < bottom; row++)
+      for(int col = 1; col < bitmap.width - 1; col++)
+        {
+        bool edge = row == top || row == bottom - 1 || col == 1 || col == bitmap.width - 2;
+        if(edge || (col * 7 + row * 3 + (int) ch) % 5 < 2)
+          bitmap.coverage[row * bitmap.width + col] = (uint8_t)(edge ? 255 : 64 + (col * 29 + row * 17 + (int) ch * 13) % 192);
+        }
+
+    return true;
+    }
+
+  virtual bool RenderGlyphs(const uint32_t *chars, size_t count, std::vector<GlyphBitmap> &bitmaps)
+    {
+    if(!FontRasterizer::RenderGlyphs(chars, count, bitmaps))
+      return false;
+
+    if(m_bPacked)
+      for(size_t i = 0; i < count; i++)
+        Pack(bitmaps[i]);
+
+    return true;
+    }
+
+private:
+  // trim a cell to its ink and pack it to 1 bit per pixel
+  static void Pack(GlyphBitmap &bitmap)
+    {
+    int left = bitmap.width;
+    int right = -1;
+    int top = -1;
+    int bottom = -1;
+    for(int row = 0; row < bitmap.height; row++)
+      for(int col = 0; col < bitmap.width; col++)
+        if(bitmap.Pixel(col, row) != 0)
+          {
+          left = col < left ? col : left;
+          right = col > right ? col : right;
+          top = top < 0 ? row : top;
+          bottom = row;
+          }
+
+    bitmap.packed = true;
+    bitmap.inkLeft = top < 0 ? 0 : left;
+    bitmap.inkTop = top < 0 ? 0 : top;
+    bitmap.inkWidth = top < 0 ? 0 : right - left + 1;
+    bitmap.inkHeight = top < 0 ? 0 : bottom - top + 1;
+
+    int stride = (bitmap.inkWidth + 7) >> 3;
+    bitmap.bits.assign(stride * bitmap.inkHeight, 0);
+    for(int row = 0; row < bitmap.inkHeight; row++)
+      for(int col = 0; col < bitmap.inkWidth; col++)
+        if(bitmap.Pixel(col + bitmap.inkLeft, row + bitmap.inkTop) != 0)
+          bitmap.bits[row * stride + (col >> 3)] |= (uint8_t)(0x80 >> (col & 7));
+
+    bitmap.coverage.clear();
+    }
+
+  bool m_bPacked;
+  int m_pixels;
+  RasterMetrics m_metrics;
+  };
+
+// a font of the check, the options apply to the default params
+struct CheckCase
+  {
+  const char *name;
+  const char *sizes;
+  const char *charSet;        // NULL for the default character set
+  int outputType;
+  int codec;
+  int bpp;
+  const char *options;        // letters of the other options, see MakeParams
+  };
+
+//   d directory, p pages of 256 bytes, a accel table, m metrics arrays,
+//   t digit tape of the first size, r rotated sets every 90 degrees,
+//   2 format v2, l run length glyphs, s no glyph sharing, 4 align to 4,
+//   k packed cells from the rasterizer
+static const CheckCase checkCases[] =
+  {
+  { "font-1bpp",      "9,12",    NULL,                                  OUTPUT_C,        -1,                1, "" },
+  { "font-4bpp",      "12",      NULL,                                  OUTPUT_C_STRING, -1,                4, "4" },
+  { "font-v2-wide",   "10",      "AZaz09 U+00E9U+4E00-U+4E07U+4E10",    OUTPUT_C,        -1,                2, "2" },
+  { "cfnt-lz4",       "9,12,15", NULL,                                  OUTPUT_BINARY,   FONT_CODEC_LZ4,    1, "lamk" },
+  { "cfnt-pages",     "12,16",   "U+0020-U+007EU+00A0-U+00FF",          OUTPUT_BINARY,   FONT_CODEC_LZSS,   2, "dp2" },
+  { "cfnt-sections",  "12",      "0123456789+-.: ABCgjpy",              OUTPUT_BASE64,   FONT_CODEC_NONE,   8, "amtr" },
+  { "cfnt-noshare",   "11",      NULL,                                  OUTPUT_BINARY,   FONT_CODEC_NONE,   1, "s" },
+  };
+
+// character sets and the code points they parse to, an empty list is an
+// error.  Escapes are not greedy so hex letters can follow them
+struct CharSetCase
+  {
+  const char *charSet;
+  const char *expected;       // sorted hex code points, space separated
+  };
+
+static const CharSetCase charSetCases[] =
+  {
+  { "U+2190-U+2193ABC",     "41 42 43 2190 2191 2192 2193" },
+  { "U+00B0ABC",            "41 42 43 b0" },
+  { "u+00e9f",              "66 e9" },
+  { "U+{1F600}-U+{1F602}E", "45 1f600 1f601 1f602" },
+  { "U+{41}U+{0042}",       "41 42" },
+  { "U+12 ",                "20 2b 31 32 55" },
+  { "U+0041-Z",             "2d 41 5a" },
+  { "U+{1F600",             "" },
+  { "U+{}",                 "" },
+  { "U+{1234567}",          "" },
+  { "U+{110000}",           "" },
+  };
+
+static bool CheckCharSet(const CharSetCase &check)
+  {
+  std::vector<uint32_t> chars;
+  std::string error;
+  std::string parsed;
+  if(FontParams::ParseCharSet(check.charSet, chars, error))
+    for(size_t n = 0; n < chars.size(); n++)
+      {
+      char hex[16];
+      sprintf(hex, n == 0 ? "%x" : " %x", (unsigned) chars[n]);
+      parsed += hex;
+      }
+
+  if(parsed != check.expected)
+    {
+    printf("FAIL charset \"%s\": parsed as \"%s\", expected \"%s\"\n", check.charSet, parsed.c_str(), check.expected);
+    return false;
+    }
+
+  return true;
+  }
+
+static bool ParseSizes(const char *arg, std::vector<int> &sizes)
+  {
+  while(*arg != 0)
+    {
+    char *end;
+    sizes.push_back((int) strtol(arg, &end, 10));
+    if(end == arg)
+      return false;
+
+    arg = *end == ',' ? end + 1 : end;
+    }
+
+  return true;
+  }
+
+static void MakeParams(const CheckCase &check, FontParams &params)
+  {
+  params.fontName = check.name;
+  params.fontFace = "synthetic";
+  if(check.charSet != NULL)
+    params.charSet = check.charSet;
+  ParseSizes(check.sizes, params.sizes);
+  params.outputType = check.outputType;
+  params.codec = check.codec;
+  params.bitsPerPixel = check.bpp;
+
+  const char *options = check.options;
+  params.recordDirectory = strchr(options, 'd') != NULL;
+  params.pageSize = strchr(options, 'p') != NULL ? 256 : 0;
+  params.accelTable = strchr(options, 'a') != NULL;
+  params.metricsTable = strchr(options, 'm') != NULL;
+  params.runLengthGlyphs = strchr(options, 'l') != NULL;
+  params.shareGlyphs = strchr(options, 's') == NULL;
+  if(strchr(options, '2') != NULL)
+    params.formatVersion = FONT_VERSION_2;
+  if(strchr(options, '4') != NULL)
+    params.alignment = 4;
+  if(strchr(options, 't') != NULL)
+    params.tapeSizes.push_back(params.sizes[0]);
+  if(strchr(options, 'r') != NULL)
+    params.stepAngle = 90;
+  }
+
+static bool ReadFile(const std::string &fileName, std::vector<uint8_t> &data)
+  {
+  FILE *file = fopen(fileName.c_str(), "rb");
+  if(file == NULL)
+    return false;
+
+  uint8_t buffer[65536];
+  size_t len;
+  data.clear();
+  while((len = fread(buffer, 1, sizeof(buffer), file)) > 0)
+    data.insert(data.end(), buffer, buffer + len);
+
+  fclose(file);
+  return true;
+  }
+
+static bool CopyFile(const std::string &from, const std::string &to)
+  {
+  std::vector<uint8_t> data;
+  if(!ReadFile(from, data))
+    return false;
+
+  FILE *file = fopen(to.c_str(), "wb");
+  if(file == NULL)
+    return false;
+
+  bool written = data.empty() || fwrite(&data[0], 1, data.size(), file) == data.size();
+  return fclose(file) == 0 && written;
+  }
+
+// build a case and compare it with its reference file, or replace the
+// reference file
+static bool CheckFont(const CheckCase &check, const std::string &goldenDir, bool update)
+  {
+  FontParams params;
+  MakeParams(check, params);
+
+  std::string reference = goldenDir + "/" + check.name + FontBuilder::OutputExtension(check.outputType);
+  std::string output = std::string(check.name) + ".out";
+
+  SyntheticRasterizer rasterizer(strchr(check.options, 'k') != NULL);
+  FontBuilder builder(params);
+  if(!builder.GenerateFontFile(rasterizer) || !builder.VerifyFontFile() || !builder.WriteOutputFile(output))
+    {
+    printf("FAIL %s: %s\n", check.name, builder.Error().c_str());
+    return false;
+    }
+
+  if(update)
+    {
+    bool copied = CopyFile(output, reference);
+    remove(output.c_str());
+    printf("%s %s\n", copied ? "wrote" : "FAIL cannot write", reference.c_str());
+    return copied;
+    }
+
+  std::vector<uint8_t> built, expected;
+  bool read = ReadFile(output, built);
+  remove(output.c_str());
+  if(!read || !ReadFile(reference, expected))
+    {
+    printf("FAIL %s: cannot read %s\n", check.name, read ? reference.c_str() : output.c_str());
+    return false;
+    }
+
+  if(built != expected)
+    {
+    size_t at = 0;
+    while(at < built.size() && at < expected.size() && built[at] == expected[at])
+      at++;
+
+    printf("FAIL %s: differs from %s at byte %u, %u bytes built, %u expected\n", check.name, reference.c_str(),
+      (unsigned) at, (unsigned) built.size(), (unsigned) expected.size());
+    return false;
+    }
+
+  printf("ok   %s\n", check.name);
+  return true;
+  }
+
+// bytes from a glyph to the end of its bitmap or runs
+static uint32_t GlyphEnd(const FontGlyphView &glyph, bool encoded)
+  {
+  uint32_t length = FONT_GLYPH_HEADER_SIZE + (encoded ? 1 : 0);
+  if(!glyph.IsRunLength())
+    return length + glyph.Stride() * glyph.Height();
+
+  const uint8_t *runs = glyph.Pixels();
+  for(int row = 0; row < glyph.Height(); row++)
+    runs += *runs == FONT_RUNS_REPEAT ? 1 : 1 + (*runs << 1);
+
+  return length + (uint32_t)(runs - glyph.Pixels());
+  }
+
+// a FONT header whose file_length ends before its records is refused
+static bool CheckShortHeader(uint16_t fileLength)
+  {
+  std::vector<uint8_t> header(FONT_HEADER_SIZE, 0);
+  memcpy(&header[0], FONT_MAGIC, 4);
+  header[FONT_LENGTH_OFFSET] = (uint8_t)(fileLength >> 8);
+  header[FONT_LENGTH_OFFSET + 1] = (uint8_t) fileLength;
+  header[FONT_NUM_FONTS_OFFSET] = 1;
+
+  FontFileView file(&header[0], header.size());
+  if(file.IsValid())
+    {
+    printf("FAIL short records: a header of file_length %u is valid\n", (unsigned) fileLength);
+    return false;
+    }
+
+  return true;
+  }
+
+// a tape whose bitmap offset wraps past the end of the section is refused
+static bool CheckTapeOffset()
+  {
+  CheckCase check = { "tape", "12", "0123456789", OUTPUT_C, -1, 1, "t" };
+  FontParams params;
+  MakeParams(check, params);
+
+  SyntheticRasterizer rasterizer(false);
+  FontBuilder builder(params);
+  if(!builder.GenerateFontFile(rasterizer))
+    {
+    printf("FAIL tape offset: %s\n", builder.Error().c_str());
+    return false;
+    }
+
+  std::vector<uint8_t> font = builder.FontFile();
+  const uint8_t *data;
+  uint32_t length;
+  FontFileView file(&font[0], font.size());
+  if(!file.FindTape(12).IsValid() || !file.FindSection(FONT_TAPE_TAG, data, length))
+    {
+    printf("FAIL tape offset: the tape does not read back\n");
+    return false;
+    }
+
+  // the offset of the first tape's bitmap
+  uint8_t *offset = &font[data - &font[0] + FONT_TAPE_HEADER_SIZE + 8];
+  offset[0] = offset[1] = offset[2] = 0xFF;
+  offset[3] = 0xF0;
+  if(FontFileView(&font[0], font.size()).FindTape(12).IsValid())
+    {
+    printf("FAIL tape offset: a tape at offset 0xFFFFFFF0 is valid\n");
+    return false;
+    }
+
+  return true;
+  }
+
+// a record cut short anywhere only finds the glyphs that are whole in it
+static bool CheckShortRecords(const char *options)
+  {
+  CheckCase check = { "short", "12", NULL, OUTPUT_C, -1, 1, options };
+  FontParams params;
+  MakeParams(check, params);
+
+  SyntheticRasterizer rasterizer(false);
+  FontBuilder builder(params);
+  std::vector<uint32_t> chars;
+  std::string error;
+  if(!builder.GenerateFontFile(rasterizer) || !FontParams::ParseCharSet(params.charSet, chars, error))
+    {
+    printf("FAIL short records: %s\n", builder.Error().c_str());
+    return false;
+    }
+
+  FontFileView file(&builder.FontFile()[0], builder.FontFile().size());
+  FontRecordView whole = file.Record(0);
+  uint32_t offsetSize = FontOffsetSize(file.Version());
+  std::vector<uint8_t> buffer(whole.Data(), whole.Data() + whole.Length());
+
+  // the end of the last glyph, the record is padded after it
+  uint32_t glyphsEnd = 0;
+  for(size_t c = 0; c < chars.size(); c++)
+    {
+    FontGlyphView glyph = whole.FindGlyph(chars[c]);
+    uint32_t end = (uint32_t)((const uint8_t *) glyph.Glyph() - whole.Data()) + GlyphEnd(glyph, whole.HasEncodedGlyphs());
+    glyphsEnd = end > glyphsEnd ? end : glyphsEnd;
+    }
+
+  for(uint32_t length = FONT_RECORD_HEADER_SIZE; length < glyphsEnd; length++)
+    {
+    // the record claims only the bytes it has left
+    std::vector<uint8_t> cut(buffer.begin(), buffer.begin() + length);
+    for(uint32_t i = 0; i < offsetSize; i++)
+      cut[i] = (uint8_t)(length >> ((offsetSize - 1 - i) << 3));
+
+    FontRecordView record(&cut[0], length, file.Version());
+    size_t found = 0;
+    for(size_t c = 0; c < chars.size() && record.IsValid(); c++)
+      {
+      FontGlyphView glyph = record.FindGlyph(chars[c]);
+      if(!glyph.IsValid())
+        continue;
+
+      uint32_t offset = (uint32_t)((const uint8_t *) glyph.Glyph() - &cut[0]);
+      if(offset + GlyphEnd(glyph, record.HasEncodedGlyphs()) > length)
+        {
+        printf("FAIL short records: a record of %u bytes finds a glyph that ends past it\n", (unsigned) length);
+        return false;
+        }
+
+      found++;
+      }
+
+    if(found == chars.size())
+      {
+      printf("FAIL short records: a record of %u bytes finds every glyph\n", (unsigned) length);
+      return false;
+      }
+    }
+
+  return true;
+  }
+
+// a size whose glyphs do not fit the bytes of a record fails to build
+static bool CheckOversize(const char *sizes, int bpp, const char *error)
+  {
+  CheckCase check = { "oversize", sizes, "AB", OUTPUT_C, -1, bpp, "" };
+  FontParams params;
+  MakeParams(check, params);
+
+  SyntheticRasterizer rasterizer(false);
+  FontBuilder builder(params);
+  if(builder.GenerateFontFile(rasterizer) || builder.Error().find(error) == std::string::npos)
+    {
+    printf("FAIL oversize %s: built with \"%s\"\n", sizes, builder.Error().c_str());
+    return false;
+    }
+
+  return true;
+  }
+
+int main(int argc, char *argv[])
+  {
+  bool update = argc == 3 && strcmp(argv[1], "--update") == 0;
+  if(argc != 2 && !update)
+    {
+    fprintf(stderr, "usage: FontCheck [--update] <golden dir>\n");
+    return 2;
+    }
+
+  std::string goldenDir = argv[argc - 1];
+  int failed = 0;
+  for(size_t n = 0; n < sizeof(charSetCases) / sizeof(charSetCases[0]); n++)
+    if(!CheckCharSet(charSetCases[n]))
+      failed++;
+
+  if(failed == 0)
+    printf("ok   charsets\n");
+
+  if(CheckShortHeader(10) && CheckShortHeader(FONT_HEADER_SIZE - 1) && CheckShortRecords("") &&
+     CheckShortRecords("l2") && CheckTapeOffset())
+    printf("ok   short records\n");
+  else
+    failed++;
+
+  if(CheckOversize("360", 8, "wide or tall") && CheckOversize("520", 1, "advances"))
+    printf("ok   oversize glyphs\n");
+  else
+    failed++;
+
+  for(size_t n = 0; n < sizeof(checkCases) / sizeof(checkCases[0]); n++)
+    if(!CheckFont(checkCases[n], goldenDir, update))
+      failed++;
+
+  if(failed > 0)
+    {
+    printf("%d checks failed\n", failed);
+    return 1;
+    }
+
+  return 0;
+  }
@@ -0,0 +1,170 @@
+#include <stdint.h>
+/* autogenerated file.  Do not edit
+Font name: font-1bpp
+Character set : ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789!"#$%&'(){}*+-,./\[]^_`:;<=>?@~| 
+Pixel sizes : 9 12 
+*/
+
+const uint8_t font-1bpp[] = {
+
+0x46, 0x4f, 0x4e, 0x54, 0x66, 0x6f, 0x6e, 0x74, 0x2d, 0x31, 0x62, 0x70, 0x70, 0x00, 0x00, 0x00, 
+0x00, 0x00, 0x00, 0x00, 0x0a, 0x00, 0x02, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 
+0x04, 0xe0, 0x09, 0x0b, 0x09, 0x01, 0x00, 0x00, 0x20, 0x7e, 0x00, 0xd0, 0x00, 0xe0, 0x00, 0xf0, 
+0x01, 0x00, 0x01, 0x10, 0x01, 0x20, 0x01, 0x30, 0x01, 0x40, 0x01, 0x50, 0x01, 0x60, 0x01, 0x70, 
+0x01, 0x80, 0x01, 0x90, 0x01, 0xa0, 0x01, 0xb0, 0x01, 0xc0, 0x01, 0xd0, 0x01, 0xe0, 0x01, 0xf0, 
+0x02, 0x00, 0x02, 0x10, 0x02, 0x20, 0x02, 0x30, 0x02, 0x40, 0x02, 0x50, 0x02, 0x60, 0x02, 0x70, 
+0x02, 0x80, 0x02, 0x90, 0x02, 0xa0, 0x02, 0xb0, 0x01, 0x40, 0x02, 0xc0, 0x02, 0xd0, 0x02, 0xe0, 
+0x02, 0xf0, 0x03, 0x00, 0x03, 0x10, 0x03, 0x20, 0x03, 0x30, 0x03, 0x40, 0x03, 0x50, 0x03, 0x60, 
+0x03, 0x70, 0x03, 0x80, 0x03, 0x90, 0x03, 0xa0, 0x01, 0xd0, 0x03, 0xb0, 0x03, 0xc0, 0x03, 0xd0, 
+0x03, 0xe0, 0x03, 0xf0, 0x04, 0x00, 0x04, 0x10, 0x04, 0x20, 0x04, 0x30, 0x04, 0x40, 0x04, 0x50, 
+0x04, 0x60, 0x04, 0x70, 0x00, 0xe0, 0x00, 0xf0, 0x01, 0x00, 0x01, 0x10, 0x01, 0x20, 0x01, 0x30, 
+0x01, 0x40, 0x01, 0x50, 0x01, 0x60, 0x01, 0x70, 0x04, 0x80, 0x01, 0x90, 0x01, 0xa0, 0x04, 0x90, 
+0x01, 0xc0, 0x04, 0xa0, 0x01, 0xe0, 0x01, 0xf0, 0x02, 0x00, 0x04, 0xb0, 0x04, 0xc0, 0x02, 0x30, 
+0x02, 0x40, 0x02, 0x50, 0x02, 0x60, 0x02, 0x70, 0x02, 0x80, 0x02, 0x90, 0x04, 0xd0, 0x02, 0xb0, 
+0x01, 0x40, 0x02, 0xc0, 0x02, 0xd0, 0x02, 0xe0, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 
+0x08, 0x09, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 
+0x06, 0x06, 0x00, 0x04, 0x06, 0xf0, 0xb0, 0x90, 0xd0, 0xb0, 0xf0, 0x00, 0x00, 0x00, 0x00, 0x00, 
+0x07, 0x05, 0x00, 0x05, 0x05, 0xf8, 0xa8, 0xd8, 0xa8, 0xf8, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 
+0x08, 0x04, 0x00, 0x06, 0x04, 0xfc, 0x94, 0xcc, 0xfc, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 
+0x06, 0x07, 0x00, 0x04, 0x07, 0xf0, 0xb0, 0x90, 0xd0, 0xb0, 0xd0, 0xf0, 0x00, 0x00, 0x00, 0x00, 
+0x07, 0x06, 0x00, 0x05, 0x06, 0xf8, 0xa8, 0xd8, 0xa8, 0x98, 0xf8, 0x00, 0x00, 0x00, 0x00, 0x00, 
+0x08, 0x05, 0x00, 0x06, 0x05, 0xfc, 0x94, 0xcc, 0xa4, 0xfc, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 
+0x06, 0x04, 0x00, 0x04, 0x04, 0xf0, 0xd0, 0xb0, 0xf0, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 
+0x07, 0x07, 0x00, 0x05, 0x07, 0xf8, 0xa8, 0xd8, 0xa8, 0x98, 0xc8, 0xf8, 0x00, 0x00, 0x00, 0x00, 
+0x08, 0x06, 0x00, 0x06, 0x06, 0xfc, 0x94, 0xcc, 0xa4, 0xd4, 0xfc, 0x00, 0x00, 0x00, 0x00, 0x00, 
+0x06, 0x05, 0x00, 0x04, 0x05, 0xf0, 0xd0, 0xb0, 0x90, 0xf0, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 
+0x07, 0x04, 0x00, 0x05, 0x04, 0xf8, 0xc8, 0xa8, 0xf8, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 
+0x08, 0x07, 0x00, 0x06, 0x07, 0xfc, 0x94, 0xcc, 0xa4, 0xd4, 0xac, 0xfc, 0x00, 0x00, 0x00, 0x00, 
+0x06, 0x06, 0x00, 0x04, 0x06, 0xf0, 0xd0, 0xb0, 0x90, 0xd0, 0xf0, 0x00, 0x00, 0x00, 0x00, 0x00, 
+0x07, 0x05, 0x00, 0x05, 0x05, 0xf8, 0xc8, 0xa8, 0xd8, 0xf8, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 
+0x08, 0x04, 0x00, 0x06, 0x04, 0xfc, 0xac, 0x94, 0xfc, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 
+0x07, 0x04, 0x00, 0x05, 0x04, 0xf8, 0xd8, 0xa8, 0xf8, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 
+0x07, 0x06, 0x00, 0x05, 0x06, 0xf8, 0xc8, 0xa8, 0xd8, 0xa8, 0xf8, 0x00, 0x00, 0x00, 0x00, 0x00, 
+0x08, 0x05, 0x00, 0x06, 0x05, 0xfc, 0xac, 0x94, 0xcc, 0xfc, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 
+0x06, 0x04, 0x00, 0x04, 0x04, 0xf0, 0xb0, 0xd0, 0xf0, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 
+0x07, 0x07, 0x00, 0x05, 0x07, 0xf8, 0xc8, 0xa8, 0xd8, 0xa8, 0x98, 0xf8, 0x00, 0x00, 0x00, 0x00, 
+0x08, 0x06, 0x00, 0x06, 0x06, 0xfc, 0xac, 0x94, 0xcc, 0xa4, 0xfc, 0x00, 0x00, 0x00, 0x00, 0x00, 
+0x06, 0x05, 0x00, 0x04, 0x05, 0xf0, 0xb0, 0xd0, 0xb0, 0xf0, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 
+0x07, 0x04, 0x00, 0x05, 0x04, 0xf8, 0x98, 0xc8, 0xf8, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 
+0x08, 0x07, 0x00, 0x06, 0x07, 0xfc, 0xac, 0x94, 0xcc, 0xa4, 0xd4, 0xfc, 0x00, 0x00, 0x00, 0x00, 
+0x06, 0x06, 0x00, 0x04, 0x06, 0xf0, 0xb0, 0xd0, 0xb0, 0x90, 0xf0, 0x00, 0x00, 0x00, 0x00, 0x00, 
+0x07, 0x05, 0x00, 0x05, 0x05, 0xf8, 0x98, 0xc8, 0xa8, 0xf8, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 
+0x08, 0x04, 0x00, 0x06, 0x04, 0xfc, 0xd4, 0xac, 0xfc, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 
+0x06, 0x07, 0x00, 0x04, 0x07, 0xf0, 0xb0, 0xd0, 0xb0, 0x90, 0xd0, 0xf0, 0x00, 0x00, 0x00, 0x00, 
+0x07, 0x06, 0x00, 0x05, 0x06, 0xf8, 0x98, 0xc8, 0xa8, 0xd8, 0xf8, 0x00, 0x00, 0x00, 0x00, 0x00, 
+0x08, 0x05, 0x00, 0x06, 0x05, 0xfc, 0xd4, 0xac, 0x94, 0xfc, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 
+0x07, 0x07, 0x00, 0x05, 0x07, 0xf8, 0x98, 0xc8, 0xa8, 0xd8, 0xa8, 0xf8, 0x00, 0x00, 0x00, 0x00, 
+0x08, 0x06, 0x00, 0x06, 0x06, 0xfc, 0xd4, 0xac, 0x94, 0xcc, 0xfc, 0x00, 0x00, 0x00, 0x00, 0x00, 
+0x06, 0x05, 0x00, 0x04, 0x05, 0xf0, 0xd0, 0xb0, 0xd0, 0xf0, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 
+0x07, 0x04, 0x00, 0x05, 0x04, 0xf8, 0xa8, 0x98, 0xf8, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 
+0x08, 0x07, 0x00, 0x06, 0x07, 0xfc, 0xd4, 0xac, 0x94, 0xcc, 0xa4, 0xfc, 0x00, 0x00, 0x00, 0x00, 
+0x06, 0x06, 0x00, 0x04, 0x06, 0xf0, 0xd0, 0xb0, 0xd0, 0xb0, 0xf0, 0x00, 0x00, 0x00, 0x00, 0x00, 
+0x07, 0x05, 0x00, 0x05, 0x05, 0xf8, 0xa8, 0x98, 0xc8, 0xf8, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 
+0x08, 0x04, 0x00, 0x06, 0x04, 0xfc, 0xa4, 0xd4, 0xfc, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 
+0x06, 0x07, 0x00, 0x04, 0x07, 0xf0, 0xd0, 0xb0, 0xd0, 0xb0, 0x90, 0xf0, 0x00, 0x00, 0x00, 0x00, 
+0x07, 0x06, 0x00, 0x05, 0x06, 0xf8, 0xa8, 0x98, 0xc8, 0xa8, 0xf8, 0x00, 0x00, 0x00, 0x00, 0x00, 
+0x08, 0x05, 0x00, 0x06, 0x05, 0xfc, 0xa4, 0xd4, 0xac, 0xfc, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 
+0x06, 0x04, 0x00, 0x04, 0x04, 0xf0, 0x90, 0xd0, 0xf0, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 
+0x07, 0x07, 0x00, 0x05, 0x07, 0xf8, 0xa8, 0x98, 0xc8, 0xa8, 0xd8, 0xf8, 0x00, 0x00, 0x00, 0x00, 
+0x08, 0x06, 0x00, 0x06, 0x06, 0xfc, 0xa4, 0xd4, 0xac, 0x94, 0xfc, 0x00, 0x00, 0x00, 0x00, 0x00, 
+0x06, 0x05, 0x00, 0x04, 0x05, 0xf0, 0x90, 0xd0, 0xb0, 0xf0, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 
+0x08, 0x07, 0x00, 0x06, 0x07, 0xfc, 0xa4, 0xd4, 0xac, 0x94, 0xcc, 0xfc, 0x00, 0x00, 0x00, 0x00, 
+0x06, 0x06, 0x00, 0x04, 0x06, 0xf0, 0x90, 0xd0, 0xb0, 0xd0, 0xf0, 0x00, 0x00, 0x00, 0x00, 0x00, 
+0x07, 0x05, 0x00, 0x05, 0x05, 0xf8, 0xd8, 0xa8, 0x98, 0xf8, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 
+0x08, 0x04, 0x00, 0x06, 0x04, 0xfc, 0xcc, 0xa4, 0xfc, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 
+0x06, 0x07, 0x00, 0x04, 0x07, 0xf0, 0x90, 0xd0, 0xb0, 0xd0, 0xb0, 0xf0, 0x00, 0x00, 0x00, 0x00, 
+0x07, 0x06, 0x00, 0x05, 0x06, 0xf8, 0xd8, 0xa8, 0x98, 0xc8, 0xf8, 0x00, 0x00, 0x00, 0x00, 0x00, 
+0x08, 0x05, 0x00, 0x06, 0x05, 0xfc, 0xcc, 0xa4, 0xd4, 0xfc, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 
+0x06, 0x04, 0x00, 0x04, 0x04, 0xf0, 0xb0, 0x90, 0xf0, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 
+0x07, 0x07, 0x00, 0x05, 0x07, 0xf8, 0xd8, 0xa8, 0x98, 0xc8, 0xa8, 0xf8, 0x00, 0x00, 0x00, 0x00, 
+0x08, 0x06, 0x00, 0x06, 0x06, 0xfc, 0xcc, 0xa4, 0xd4, 0xac, 0xfc, 0x00, 0x00, 0x00, 0x00, 0x00, 
+0x06, 0x05, 0x00, 0x04, 0x05, 0xf0, 0xb0, 0x90, 0xd0, 0xf0, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 
+0x07, 0x04, 0x00, 0x05, 0x04, 0xf8, 0xa8, 0xd8, 0xf8, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 
+0x08, 0x07, 0x00, 0x06, 0x07, 0xfc, 0xcc, 0xa4, 0xd4, 0xac, 0x94, 0xfc, 0x00, 0x00, 0x00, 0x00, 
+0x07, 0x04, 0x00, 0x05, 0x06, 0xf8, 0xc8, 0xa8, 0xd8, 0xa8, 0xf8, 0x00, 0x00, 0x00, 0x00, 0x00, 
+0x07, 0x05, 0x00, 0x05, 0x07, 0xf8, 0xc8, 0xa8, 0xd8, 0xa8, 0x98, 0xf8, 0x00, 0x00, 0x00, 0x00, 
+0x06, 0x07, 0x00, 0x04, 0x07, 0xf0, 0xd0, 0xb0, 0x90, 0xd0, 0xb0, 0xf0, 0x00, 0x00, 0x00, 0x00, 
+0x07, 0x07, 0x00, 0x05, 0x09, 0xf8, 0xc8, 0xa8, 0xd8, 0xa8, 0x98, 0xc8, 0xa8, 0xf8, 0x00, 0x00, 
+0x08, 0x06, 0x00, 0x06, 0x08, 0xfc, 0xac, 0x94, 0xcc, 0xa4, 0xd4, 0xac, 0xfc, 0x00, 0x00, 0x00, 
+0x07, 0x06, 0x00, 0x05, 0x08, 0xf8, 0x98, 0xc8, 0xa8, 0xd8, 0xa8, 0x98, 0xf8, 0x00, 0x00, 0x00, 
+0x05, 0x00, 0x0c, 0x0f, 0x0c, 0x01, 0x00, 0x00, 0x20, 0x7e, 0x00, 0xd0, 0x00, 0xe0, 0x00, 0xf0, 
+0x01, 0x00, 0x01, 0x10, 0x01, 0x20, 0x01, 0x30, 0x01, 0x40, 0x01, 0x50, 0x01, 0x60, 0x01, 0x70, 
+0x01, 0x80, 0x01, 0x90, 0x01, 0xa0, 0x01, 0xb0, 0x01, 0xc0, 0x01, 0xd0, 0x01, 0xe0, 0x01, 0xf0, 
+0x02, 0x00, 0x02, 0x10, 0x02, 0x20, 0x02, 0x30, 0x02, 0x40, 0x02, 0x50, 0x02, 0x60, 0x02, 0x70, 
+0x02, 0x80, 0x02, 0x90, 0x02, 0xa0, 0x02, 0xb0, 0x02, 0xc0, 0x02, 0xd0, 0x02, 0xe0, 0x02, 0xf0, 
+0x03, 0x00, 0x03, 0x10, 0x03, 0x20, 0x03, 0x30, 0x03, 0x40, 0x03, 0x50, 0x03, 0x60, 0x03, 0x70, 
+0x03, 0x80, 0x03, 0x90, 0x03, 0xa0, 0x03, 0xb0, 0x01, 0xd0, 0x03, 0xc0, 0x03, 0xd0, 0x03, 0xe0, 
+0x03, 0xf0, 0x04, 0x00, 0x04, 0x10, 0x04, 0x20, 0x04, 0x30, 0x04, 0x40, 0x04, 0x50, 0x04, 0x60, 
+0x04, 0x70, 0x04, 0x80, 0x00, 0xe0, 0x00, 0xf0, 0x01, 0x00, 0x01, 0x10, 0x01, 0x20, 0x01, 0x30, 
+0x01, 0x40, 0x01, 0x50, 0x01, 0x60, 0x01, 0x70, 0x04, 0x90, 0x01, 0x90, 0x01, 0xa0, 0x04, 0xa0, 
+0x01, 0xc0, 0x04, 0xb0, 0x01, 0xe0, 0x01, 0xf0, 0x02, 0x00, 0x04, 0xc0, 0x04, 0xe0, 0x02, 0x30, 
+0x02, 0x40, 0x02, 0x50, 0x02, 0x60, 0x02, 0x70, 0x02, 0x80, 0x02, 0x90, 0x04, 0xf0, 0x02, 0xb0, 
+0x02, 0xc0, 0x02, 0xd0, 0x02, 0xe0, 0x02, 0xf0, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 
+0x0a, 0x0c, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 
+0x08, 0x08, 0x00, 0x06, 0x08, 0xfc, 0x94, 0xcc, 0xa4, 0xd4, 0xac, 0x94, 0xfc, 0x00, 0x00, 0x00, 
+0x09, 0x07, 0x00, 0x07, 0x07, 0xfe, 0xd2, 0xaa, 0x96, 0xca, 0xa6, 0xfe, 0x00, 0x00, 0x00, 0x00, 
+0x0a, 0x06, 0x00, 0x08, 0x06, 0xff, 0xcb, 0xa5, 0xd3, 0xa9, 0xff, 0x00, 0x00, 0x00, 0x00, 0x00, 
+0x08, 0x09, 0x00, 0x06, 0x09, 0xfc, 0x94, 0xcc, 0xa4, 0xd4, 0xac, 0x94, 0xcc, 0xfc, 0x00, 0x00, 
+0x09, 0x08, 0x00, 0x07, 0x08, 0xfe, 0xd2, 0xaa, 0x96, 0xca, 0xa6, 0xd2, 0xfe, 0x00, 0x00, 0x00, 
+0x0a, 0x07, 0x00, 0x08, 0x07, 0xff, 0xcb, 0xa5, 0xd3, 0xa9, 0x95, 0xff, 0x00, 0x00, 0x00, 0x00, 
+0x08, 0x06, 0x00, 0x06, 0x06, 0xfc, 0xac, 0x94, 0xcc, 0xa4, 0xfc, 0x00, 0x00, 0x00, 0x00, 0x00, 
+0x09, 0x09, 0x00, 0x07, 0x09, 0xfe, 0xd2, 0xaa, 0x96, 0xca, 0xa6, 0xd2, 0xaa, 0xfe, 0x00, 0x00, 
+0x0a, 0x08, 0x00, 0x08, 0x08, 0xff, 0xcb, 0xa5, 0xd3, 0xa9, 0x95, 0xcb, 0xff, 0x00, 0x00, 0x00, 
+0x08, 0x07, 0x00, 0x06, 0x07, 0xfc, 0xac, 0x94, 0xcc, 0xa4, 0xd4, 0xfc, 0x00, 0x00, 0x00, 0x00, 
+0x09, 0x06, 0x00, 0x07, 0x06, 0xfe, 0xa6, 0xd2, 0xaa, 0x96, 0xfe, 0x00, 0x00, 0x00, 0x00, 0x00, 
+0x0a, 0x09, 0x00, 0x08, 0x09, 0xff, 0xcb, 0xa5, 0xd3, 0xa9, 0x95, 0xcb, 0xa5, 0xff, 0x00, 0x00, 
+0x08, 0x08, 0x00, 0x06, 0x08, 0xfc, 0xac, 0x94, 0xcc, 0xa4, 0xd4, 0xac, 0xfc, 0x00, 0x00, 0x00, 
+0x09, 0x07, 0x00, 0x07, 0x07, 0xfe, 0xa6, 0xd2, 0xaa, 0x96, 0xca, 0xfe, 0x00, 0x00, 0x00, 0x00, 
+0x0a, 0x06, 0x00, 0x08, 0x06, 0xff, 0x95, 0xcb, 0xa5, 0xd3, 0xff, 0x00, 0x00, 0x00, 0x00, 0x00, 
+0x09, 0x06, 0x00, 0x07, 0x06, 0xfe, 0xaa, 0x96, 0xca, 0xa6, 0xfe, 0x00, 0x00, 0x00, 0x00, 0x00, 
+0x09, 0x08, 0x00, 0x07, 0x08, 0xfe, 0xa6, 0xd2, 0xaa, 0x96, 0xca, 0xa6, 0xfe, 0x00, 0x00, 0x00, 
+0x0a, 0x07, 0x00, 0x08, 0x07, 0xff, 0x95, 0xcb, 0xa5, 0xd3, 0xa9, 0xff, 0x00, 0x00, 0x00, 0x00, 
+0x08, 0x06, 0x00, 0x06, 0x06, 0xfc, 0xd4, 0xac, 0x94, 0xcc, 0xfc, 0x00, 0x00, 0x00, 0x00, 0x00, 
+0x09, 0x09, 0x00, 0x07, 0x09, 0xfe, 0xa6, 0xd2, 0xaa, 0x96, 0xca, 0xa6, 0xd2, 0xfe, 0x00, 0x00, 
+0x0a, 0x08, 0x00, 0x08, 0x08, 0xff, 0x95, 0xcb, 0xa5, 0xd3, 0xa9, 0x95, 0xff, 0x00, 0x00, 0x00, 
+0x08, 0x07, 0x00, 0x06, 0x07, 0xfc, 0xd4, 0xac, 0x94, 0xcc, 0xa4, 0xfc, 0x00, 0x00, 0x00, 0x00, 
+0x09, 0x06, 0x00, 0x07, 0x06, 0xfe, 0xca, 0xa6, 0xd2, 0xaa, 0xfe, 0x00, 0x00, 0x00, 0x00, 0x00, 
+0x0a, 0x09, 0x00, 0x08, 0x09, 0xff, 0x95, 0xcb, 0xa5, 0xd3, 0xa9, 0x95, 0xcb, 0xff, 0x00, 0x00, 
+0x08, 0x08, 0x00, 0x06, 0x08, 0xfc, 0xd4, 0xac, 0x94, 0xcc, 0xa4, 0xd4, 0xfc, 0x00, 0x00, 0x00, 
+0x09, 0x07, 0x00, 0x07, 0x07, 0xfe, 0xca, 0xa6, 0xd2, 0xaa, 0x96, 0xfe, 0x00, 0x00, 0x00, 0x00, 
+0x0a, 0x06, 0x00, 0x08, 0x06, 0xff, 0xa9, 0x95, 0xcb, 0xa5, 0xff, 0x00, 0x00, 0x00, 0x00, 0x00, 
+0x08, 0x09, 0x00, 0x06, 0x09, 0xfc, 0xd4, 0xac, 0x94, 0xcc, 0xa4, 0xd4, 0xac, 0xfc, 0x00, 0x00, 
+0x09, 0x08, 0x00, 0x07, 0x08, 0xfe, 0xca, 0xa6, 0xd2, 0xaa, 0x96, 0xca, 0xfe, 0x00, 0x00, 0x00, 
+0x0a, 0x07, 0x00, 0x08, 0x07, 0xff, 0xa9, 0x95, 0xcb, 0xa5, 0xd3, 0xff, 0x00, 0x00, 0x00, 0x00, 
+0x08, 0x06, 0x00, 0x06, 0x06, 0xfc, 0xa4, 0xd4, 0xac, 0x94, 0xfc, 0x00, 0x00, 0x00, 0x00, 0x00, 
+0x09, 0x09, 0x00, 0x07, 0x09, 0xfe, 0xca, 0xa6, 0xd2, 0xaa, 0x96, 0xca, 0xa6, 0xfe, 0x00, 0x00, 
+0x0a, 0x08, 0x00, 0x08, 0x08, 0xff, 0xa9, 0x95, 0xcb, 0xa5, 0xd3, 0xa9, 0xff, 0x00, 0x00, 0x00, 
+0x08, 0x07, 0x00, 0x06, 0x07, 0xfc, 0xa4, 0xd4, 0xac, 0x94, 0xcc, 0xfc, 0x00, 0x00, 0x00, 0x00, 
+0x09, 0x06, 0x00, 0x07, 0x06, 0xfe, 0x96, 0xca, 0xa6, 0xd2, 0xfe, 0x00, 0x00, 0x00, 0x00, 0x00, 
+0x0a, 0x09, 0x00, 0x08, 0x09, 0xff, 0xa9, 0x95, 0xcb, 0xa5, 0xd3, 0xa9, 0x95, 0xff, 0x00, 0x00, 
+0x08, 0x08, 0x00, 0x06, 0x08, 0xfc, 0xa4, 0xd4, 0xac, 0x94, 0xcc, 0xa4, 0xfc, 0x00, 0x00, 0x00, 
+0x09, 0x07, 0x00, 0x07, 0x07, 0xfe, 0x96, 0xca, 0xa6, 0xd2, 0xaa, 0xfe, 0x00, 0x00, 0x00, 0x00, 
+0x0a, 0x06, 0x00, 0x08, 0x06, 0xff, 0xd3, 0xa9, 0x95, 0xcb, 0xff, 0x00, 0x00, 0x00, 0x00, 0x00, 
+0x08, 0x09, 0x00, 0x06, 0x09, 0xfc, 0xa4, 0xd4, 0xac, 0x94, 0xcc, 0xa4, 0xd4, 0xfc, 0x00, 0x00, 
+0x09, 0x08, 0x00, 0x07, 0x08, 0xfe, 0x96, 0xca, 0xa6, 0xd2, 0xaa, 0x96, 0xfe, 0x00, 0x00, 0x00, 
+0x0a, 0x07, 0x00, 0x08, 0x07, 0xff, 0xd3, 0xa9, 0x95, 0xcb, 0xa5, 0xff, 0x00, 0x00, 0x00, 0x00, 
+0x08, 0x06, 0x00, 0x06, 0x06, 0xfc, 0xcc, 0xa4, 0xd4, 0xac, 0xfc, 0x00, 0x00, 0x00, 0x00, 0x00, 
+0x09, 0x09, 0x00, 0x07, 0x09, 0xfe, 0x96, 0xca, 0xa6, 0xd2, 0xaa, 0x96, 0xca, 0xfe, 0x00, 0x00, 
+0x0a, 0x08, 0x00, 0x08, 0x08, 0xff, 0xd3, 0xa9, 0x95, 0xcb, 0xa5, 0xd3, 0xff, 0x00, 0x00, 0x00, 
+0x08, 0x07, 0x00, 0x06, 0x07, 0xfc, 0xcc, 0xa4, 0xd4, 0xac, 0x94, 0xfc, 0x00, 0x00, 0x00, 0x00, 
+0x0a, 0x09, 0x00, 0x08, 0x09, 0xff, 0xd3, 0xa9, 0x95, 0xcb, 0xa5, 0xd3, 0xa9, 0xff, 0x00, 0x00, 
+0x08, 0x08, 0x00, 0x06, 0x08, 0xfc, 0xcc, 0xa4, 0xd4, 0xac, 0x94, 0xcc, 0xfc, 0x00, 0x00, 0x00, 
+0x09, 0x07, 0x00, 0x07, 0x07, 0xfe, 0xaa, 0x96, 0xca, 0xa6, 0xd2, 0xfe, 0x00, 0x00, 0x00, 0x00, 
+0x0a, 0x06, 0x00, 0x08, 0x06, 0xff, 0xa5, 0xd3, 0xa9, 0x95, 0xff, 0x00, 0x00, 0x00, 0x00, 0x00, 
+0x08, 0x09, 0x00, 0x06, 0x09, 0xfc, 0xcc, 0xa4, 0xd4, 0xac, 0x94, 0xcc, 0xa4, 0xfc, 0x00, 0x00, 
+0x09, 0x08, 0x00, 0x07, 0x08, 0xfe, 0xaa, 0x96, 0xca, 0xa6, 0xd2, 0xaa, 0xfe, 0x00, 0x00, 0x00, 
+0x0a, 0x07, 0x00, 0x08, 0x07, 0xff, 0xa5, 0xd3, 0xa9, 0x95, 0xcb, 0xff, 0x00, 0x00, 0x00, 0x00, 
+0x08, 0x06, 0x00, 0x06, 0x06, 0xfc, 0x94, 0xcc, 0xa4, 0xd4, 0xfc, 0x00, 0x00, 0x00, 0x00, 0x00, 
+0x09, 0x09, 0x00, 0x07, 0x09, 0xfe, 0xaa, 0x96, 0xca, 0xa6, 0xd2, 0xaa, 0x96, 0xfe, 0x00, 0x00, 
+0x0a, 0x08, 0x00, 0x08, 0x08, 0xff, 0xa5, 0xd3, 0xa9, 0x95, 0xcb, 0xa5, 0xff, 0x00, 0x00, 0x00, 
+0x08, 0x07, 0x00, 0x06, 0x07, 0xfc, 0x94, 0xcc, 0xa4, 0xd4, 0xac, 0xfc, 0x00, 0x00, 0x00, 0x00, 
+0x09, 0x06, 0x00, 0x07, 0x06, 0xfe, 0xd2, 0xaa, 0x96, 0xca, 0xfe, 0x00, 0x00, 0x00, 0x00, 0x00, 
+0x0a, 0x09, 0x00, 0x08, 0x09, 0xff, 0xa5, 0xd3, 0xa9, 0x95, 0xcb, 0xa5, 0xd3, 0xff, 0x00, 0x00, 
+0x09, 0x06, 0x00, 0x07, 0x09, 0xfe, 0xa6, 0xd2, 0xaa, 0x96, 0xca, 0xa6, 0xd2, 0xfe, 0x00, 0x00, 
+0x09, 0x07, 0x00, 0x07, 0x0a, 0xfe, 0xa6, 0xd2, 0xaa, 0x96, 0xca, 0xa6, 0xd2, 0xaa, 0xfe, 0x00, 
+0x08, 0x09, 0x00, 0x06, 0x09, 0xfc, 0xac, 0x94, 0xcc, 0xa4, 0xd4, 0xac, 0x94, 0xfc, 0x00, 0x00, 
+0x09, 0x09, 0x00, 0x07, 0x0c, 0xfe, 0xa6, 0xd2, 0xaa, 0x96, 0xca, 0xa6, 0xd2, 0xaa, 0x96, 0xca, 
+0xfe, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 
+0x0a, 0x08, 0x00, 0x08, 0x0b, 0xff, 0x95, 0xcb, 0xa5, 0xd3, 0xa9, 0x95, 0xcb, 0xa5, 0xd3, 0xff, 
+0x09, 0x08, 0x00, 0x07, 0x0b, 0xfe, 0xca, 0xa6, 0xd2, 0xaa, 0x96, 0xca, 0xa6, 0xd2, 0xaa, 0xfe, };
+const uint16_t font-1bpp_length = 2560;
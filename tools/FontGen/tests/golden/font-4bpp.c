@@ -0,0 +1,155 @@
+#include <stdint.h>
+/* autogenerated file.  Do not edit
+Font name: font-4bpp
+Character set : ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789!"#$%&'(){}*+-,./\[]^_`:;<=>?@~| 
+Pixel sizes : 12 
+*/
+
+const uint8_t font-4bpp[3552] =
+"FONTfont-4bpp\0\0\0\0\0\0\0\15\340\1\0\0\0\0\0\0\0\0\0\15\300\14\17\14\1\4\0"
+" ~\0\310\0\320\0\360\1\24\0014\1T\1|\1\240\1\270\1\344\2\14\2(\2H\2t\2\224\2"
+"\270\2\330\2\370\3 \3D\3\\\3\210\3\260\3\314\3\354\4\30\48\4\\\4|\4\234\4\304"
+"\4\350\5\0\5,\5T\5p\5\220\5\274\5\334\6\0\6 \6@\6h\6\214\6\244\6\320\6\370\2"
+"\330\7\24\7@\7`\7\204\7\244\7\304\7\354\10\20\10(\10T\10|\10\230\10\270\10\344"
+"\11\4\11(\11H\11h\11\220\11\264\11\314\11\370\n \n<\nh\n\224\n\264\n\344\13"
+"\4\13$\13L\13p\13\210\13\300\13\364\14\20\0140\14\\\14|\14\240\14\300\14\340"
+"\15\24\158\15P\15|\15\244\n\14\0\0\0\0\0\0\10\10\0\6\10\377\377\377\360\7\17"
+"\365\0\257\360p\17\367\n\17\360\220\337\360\14\17\377\377\377\0\0\0\11\7\0\7"
+"\7\377\377\377\360\365\11\0\360\360\200\260\360\360\13\16\360\370\0\320\360"
+"\360\260\5\360\377\377\377\360\0\0\0\n\6\0\10\6\377\377\377\377\367\0\300O\360"
+"\240\17\17\371\14\0o\360\300@\17\377\377\377\377\0\0\0\10\11\0\6\11\377\377"
+"\377\360\10\17\366\0\277\360\220\17\370\13\17\360\260\357\360\15\17\373\0_\377"
+"\377\377\11\10\0\7\10\377\377\377\360\367\n\0\360\360\220\320\360\360\14\4\360"
+"\372\0\360\360\360\300\6\360\374\17\0\360\377\377\377\360\0\0\0\n\7\0\10\7\377"
+"\377\377\377\370\0\320o\360\260\5\17\372\16\0\217\360\320P\17\360\4\10\17\377"
+"\377\377\377\0\0\0\10\6\0\6\6\377\377\377\360\300O\360\17\17\374\0o\360\360"
+"\17\377\377\377\0\11\11\0\7\11\377\377\377\360\370\13\0\360\360\260\340\360"
+"\360\15\5\360\373\0P\360\360\340\7\360\375\5\0\360\360@\200\360\377\377\377"
+"\360\0\0\0\n\10\0\10\10\377\377\377\377\372\0\360\177\360\300\6\17\374\4\0\237"
+"\360\340`\17\360\6\11\17\377\0\200\317\377\377\377\377\0\0\0\10\7\0\6\7\377"
+"\377\377\360\320_\360\5\17\375\0\177\360P\17\364\10\17\377\377\377\0\0\11\6"
+"\0\7\6\377\377\377\360\360\360\11\360\376\6\0\360\360`\220\360\360\10\14\360"
+"\377\377\377\360\0\0\0\n\11\0\10\11\377\377\377\377\373\0P\217\360\340\7\17"
+"\375\5\0\257\360@\200\17\360\7\n\17\365\0\240\337\360p\14\17\377\377\377\377"
+"\0\0\0\10\10\0\6\10\377\377\377\360\340\177\360\6\17\377\0\237\360`\17\365\11"
+"\17\360\200\317\377\377\377\0\0\0\11\7\0\7\7\377\377\377\360\360P\n\360\364"
+"\10\0\360\360p\240\360\360\n\15\360\367\0\300\360\377\377\377\360\0\0\0\n\6"
+"\0\10\6\377\377\377\377\360\10\14\17\366\0\260\357\360\220\16\17\370\13\0_\377"
+"\377\377\377\0\0\0\11\6\0\7\6\377\377\377\360\360\220\300\360\360\13\17\360"
+"\371\0\340\360\360\300\5\360\377\377\377\360\0\0\0\11\10\0\7\10\377\377\377"
+"\360\360`\13\360\365\11\0\360\360\200\300\360\360\13\16\360\370\0\340\360\360"
+"\260\5\360\377\377\377\360\0\0\0\n\7\0\10\7\377\377\377\377\360\n\15\17\367"
+"\0\300O\360\240\4\17\371\15\0o\360\300@\17\377\377\377\377\0\0\0\10\6\0\6\6"
+"\377\377\377\370\13\17\360\260\357\360\15\17\373\0_\377\377\377\0\11\11\0\7"
+"\11\377\377\377\360\360p\15\360\367\n\0\360\360\220\320\360\360\14\4\360\372"
+"\0\360\360\360\300\6\360\374\4\0\360\377\377\377\360\0\0\0\n\10\0\10\10\377"
+"\377\377\377\360\13\16\17\371\0\340o\360\260\5\17\373\16\0\217\360\320P\17\360"
+"\5\10\17\377\377\377\377\0\0\0\10\7\0\6\7\377\377\377\371\15\17\360\300O\360"
+"\17\17\374\0o\360\360\17\377\377\377\0\0\11\6\0\7\6\377\377\377\360\373\0P\360"
+"\360\340\10\360\375\5\0\360\360@\200\360\377\377\377\360\0\0\0\n\11\0\10\11"
+"\377\377\377\377\360\14\4\17\372\0\360\177\360\320\6\17\374\4\0\237\360\360"
+"p\17\360\6\11\17\377\0\220\317\377\377\377\377\0\0\0\10\10\0\6\10\377\377\377"
+"\373\16\17\360\320_\360\5\17\376\0\177\360P\17\364\10\17\377\377\377\0\0\0\11"
+"\7\0\7\7\377\377\377\360\374\0`\360\360@\11\360\376\6\0\360\360`\220\360\360"
+"\10\14\360\377\377\377\360\0\0\0\n\6\0\10\6\377\377\377\377\360P\200\17\360"
+"\7\13\17\365\0\240\337\360\200\15\17\377\377\377\377\0\0\0\10\11\0\6\11\377"
+"\377\377\374\4\17\360\360\177\360\6\17\377\0\237\360`\17\366\11\17\360\200\317"
+"\377\377\377\11\10\0\7\10\377\377\377\360\376\0p\360\360P\n\360\364\10\0\360"
+"\360p\240\360\360\n\15\360\367\0\300\360\377\377\377\360\0\0\0\n\7\0\10\7\377"
+"\377\377\377\360`\220\17\360\11\14\17\366\0\260\377\360\220\16\17\370\14\0_"
+"\377\377\377\377\0\0\0\10\6\0\6\6\377\377\377\360\200\17\367\n\17\360\240\337"
+"\360\14\17\377\377\377\0\11\11\0\7\11\377\377\377\360\377\0\220\360\360`\13"
+"\360\366\11\0\360\360\200\300\360\360\13\16\360\371\0\340\360\360\260\5\360"
+"\377\377\377\360\0\0\0\n\10\0\10\10\377\377\377\377\360p\260\17\360\n\15\17"
+"\367\0\320_\360\240\4\17\371\15\0\177\360\300@\17\377\377\377\377\0\0\0\10\7"
+"\0\6\7\377\377\377\360\220\17\370\14\17\360\260\357\360\16\17\373\0_\377\377"
+"\377\0\0\11\6\0\7\6\377\377\377\360\360\14\4\360\372\0@\360\360\320\6\360\374"
+"\4\0\360\377\377\377\360\0\0\0\n\11\0\10\11\377\377\377\377\360\200\300\17\360"
+"\13\17\17\371\0\340o\360\260\5\17\373\16\0\217\360\320`\17\360\5\10\17\377\377"
+"\377\377\0\0\0\10\10\0\6\10\377\377\377\360\240\17\371\15\17\360\300O\360\17"
+"\17\374\0o\360@\17\377\377\377\0\0\0\11\7\0\7\7\377\377\377\360\360\16\6\360"
+"\373\0P\360\360\340\10\360\375\5\0\360\360P\200\360\377\377\377\360\0\0\0\n"
+"\6\0\10\6\377\377\377\377\374\4\0\237\360\360p\17\360\6\n\17\377\0\220\317\377"
+"\377\377\377\0\0\0\10\11\0\6\11\377\377\377\360\260\17\373\16\17\360\320o\360"
+"\5\17\376\0\217\360P\17\364\10\17\377\377\377\11\10\0\7\10\377\377\377\360\360"
+"\17\7\360\375\0`\360\360@\11\360\377\7\0\360\360`\220\360\360\11\14\360\377"
+"\377\377\360\0\0\0\n\7\0\10\7\377\377\377\377\375\5\0\277\360P\200\17\360\7"
+"\13\17\365\0\240\357\360\200\15\17\377\377\377\377\0\0\0\10\6\0\6\6\377\377"
+"\377\364\0\237\360`\17\366\11\17\360\200\317\377\377\377\0\11\11\0\7\11\377"
+"\377\377\360\360\5\10\360\376\0\200\360\360P\n\360\365\10\0\360\360p\260\360"
+"\360\n\15\360\370\0\320\360\377\377\377\360\0\0\0\n\10\0\10\10\377\377\377\377"
+"\377\7\0\317\360`\220\17\360\11\14\17\366\0\260\377\360\220\16\17\370\14\0o"
+"\377\377\377\377\0\0\0\10\7\0\6\7\377\377\377\365\0\257\360\200\17\367\n\17"
+"\360\240\337\360\14\17\377\377\377\0\0\n\11\0\10\11\377\377\377\377\365\10\0"
+"\337\360p\260\17\360\n\15\17\370\0\320_\360\240\4\17\372\15\0\177\360\300@\17"
+"\377\377\377\377\0\0\0\10\10\0\6\10\377\377\377\366\0\277\360\220\17\370\14"
+"\17\360\260\357\360\16\17\373\0_\377\377\377\0\0\0\11\7\0\7\7\377\377\377\360"
+"\360\240\320\360\360\15\5\360\372\0@\360\360\320\7\360\374\4\0\360\377\377\377"
+"\360\0\0\0\n\6\0\10\6\377\377\377\377\360\300\5\17\373\16\0\217\360\340`\17"
+"\360\5\10\17\377\377\377\377\0\0\0\10\11\0\6\11\377\377\377\370\0\337\360\240"
+"\17\372\15\17\360\300O\360\4\17\375\0o\360@\17\377\377\377\11\10\0\7\10\377"
+"\377\377\360\360\260\360\360\360\16\6\360\373\0P\360\360\340\10\360\375\6\0"
+"\360\360P\200\360\377\377\377\360\0\0\0\n\7\0\10\7\377\377\377\377\360\320\7"
+"\17\374\4\0\237\360\360p\17\360\6\n\17\364\0\220\317\377\377\377\377\0\0\0\10"
+"\6\0\6\6\377\377\377\360\5\17\376\0\217\360P\17\365\10\17\377\377\377\0\11\11"
+"\0\7\11\377\377\377\360\360\300P\360\360\4\7\360\375\0p\360\360@\11\360\377"
+"\7\0\360\360`\240\360\360\11\14\360\377\377\377\360\0\0\0\n\10\0\10\10\377\377"
+"\377\377\360\340\10\17\375\6\0\277\360P\200\17\360\10\13\17\365\0\240\357\360"
+"\200\15\17\377\377\377\377\0\0\0\10\7\0\6\7\377\377\377\360\6\17\364\0\237\360"
+"p\17\366\11\17\360\220\317\377\377\377\0\0\11\6\0\7\6\377\377\377\360\365\10"
+"\0\360\360p\260\360\360\n\16\360\370\0\320\360\377\377\377\360\0\0\0\n\11\0"
+"\10\11\377\377\377\377\360@\11\17\377\7\0\317\360`\240\17\360\11\14\17\366\0"
+"\300\377\360\220\16\17\370\14\0o\377\377\377\377\0\0\0\10\10\0\6\10\377\377"
+"\377\360\10\17\365\0\257\360\200\17\367\13\17\360\240\337\360\15\17\377\377"
+"\377\0\0\0\11\7\0\7\7\377\377\377\360\366\11\0\360\360\220\300\360\360\13\17"
+"\360\371\0\340\360\360\300\6\360\377\377\377\360\0\0\0\n\6\0\10\6\377\377\377"
+"\377\370\0\320_\360\240\4\17\372\15\0\177\360\300P\17\377\377\377\377\0\0\0"
+"\10\11\0\6\11\377\377\377\360\11\17\367\0\317\360\220\17\371\14\17\360\260\377"
+"\360\16\17\374\0_\377\377\377\11\10\0\7\10\377\377\377\360\367\13\0\360\360"
+"\240\320\360\360\15\5\360\372\0@\360\360\320\7\360\374\4\0\360\377\377\377\360"
+"\0\0\0\n\7\0\10\7\377\377\377\377\371\0\340o\360\300\6\17\373\16\0\217\360\340"
+"`\17\360\5\11\17\377\377\377\377\0\0\0\10\6\0\6\6\377\377\377\360\320_\360\4"
+"\17\375\0\177\360@\17\377\377\377\0\11\11\0\7\11\377\377\377\360\371\14\0\360"
+"\360\260\360\360\360\16\6\360\374\0P\360\360\340\10\360\376\6\0\360\360P\200"
+"\360\377\377\377\360\0\0\0\n\10\0\10\10\377\377\377\377\372\0@\217\360\320\7"
+"\17\374\4\0\257\360@p\17\360\6\n\17\364\0\220\337\377\377\377\377\0\0\0\10\7"
+"\0\6\7\377\377\377\360\340o\360\5\17\376\0\217\360`\17\365\10\17\377\377\377"
+"\0\0\11\6\0\7\11\377\377\377\360\360@\11\360\377\7\0\360\360`\240\360\360\11"
+"\14\360\367\0\300\360\360\220\16\360\371\14\0\360\377\377\377\360\0\0\0\n\11"
+"\0\10\11\377\377\377\377\374\0P\237\360\340\10\17\376\6\0\277\360P\200\17\360"
+"\10\13\17\365\0\240\357\360\200\15\17\377\377\377\377\0\0\0\10\10\0\6\10\377"
+"\377\377\360@\177\360\7\17\364\0\237\360p\17\366\n\17\360\220\317\377\377\377"
+"\0\0\0\11\7\0\7\n\377\377\377\360\360`\13\360\365\10\0\360\360\200\260\360\360"
+"\n\16\360\370\0\320\360\360\260\4\360\372\15\0\360\360\320P\360\377\377\377"
+"\360\0\0\0\n\6\0\10\6\377\377\377\377\360\11\14\17\367\0\300O\360\220\16\17"
+"\371\14\0o\377\377\377\377\0\0\0\10\11\0\6\11\377\377\377\360P\237\360\10\17"
+"\365\0\277\360\200\17\367\13\17\360\240\357\360\15\17\377\377\377\11\10\0\7"
+"\10\377\377\377\360\360p\14\360\366\n\0\360\360\220\300\360\360\14\17\360\371"
+"\0\340\360\360\300\6\360\377\377\377\360\0\0\0\n\7\0\10\7\377\377\377\377\360"
+"\n\16\17\370\0\320_\360\260\4\17\372\15\0\177\360\320P\17\377\377\377\377\0"
+"\0\0\10\6\0\6\6\377\377\377\371\14\17\360\260\377\360\16\17\374\0o\377\377\377"
+"\0\11\11\0\7\14\377\377\377\360\360\200\15\360\367\13\0\360\360\240\340\360"
+"\360\15\5\360\372\0@\360\360\320\7\360\374\5\0\360\360@p\360\360\7\n\360\364"
+"\0\220\360\377\377\377\360\0\0\0\n\10\0\10\13\377\377\377\377\360\14\4\17\371"
+"\0\340o\360\300\6\17\373\17\0\217\360\340`\17\360\5\11\17\376\0\200\277\360"
+"`\13\17\365\10\0\337\377\377\377\377\0\0\0\10\7\0\6\7\377\377\377\372\15\17"
+"\360\320_\360\4\17\375\0\177\360@\17\377\377\377\0\0\11\6\0\7\6\377\377\377"
+"\360\374\0`\360\360\340\10\360\376\6\0\360\360P\220\360\377\377\377\360\0\0"
+"\0\n\11\0\10\11\377\377\377\377\360\15\5\17\373\0@\217\360\320\7\17\375\5\0"
+"\257\360@p\17\360\7\n\17\364\0\220\337\377\377\377\377\0\0\0\10\10\0\6\10\377"
+"\377\377\373\17\17\360\340o\360\5\17\376\0\217\360`\17\365\10\17\377\377\377"
+"\0\0\0\11\7\0\7\7\377\377\377\360\375\0p\360\360@\n\360\364\7\0\360\360`\240"
+"\360\360\11\15\360\377\377\377\360\0\0\0\n\6\0\10\6\377\377\377\377\360P\220"
+"\17\360\10\13\17\366\0\260\357\360\200\15\17\377\377\377\377\0\0\0\10\11\0\6"
+"\11\377\377\377\375\5\17\360@\177\360\7\17\364\0\237\360p\17\366\n\17\360\220"
+"\317\377\377\377\11\10\0\7\13\377\377\377\360\376\0\200\360\360`\13\360\365"
+"\10\0\360\360\200\260\360\360\n\16\360\370\0\320\360\360\260\5\360\372\15\0"
+"\360\360\320P\360\377\377\377\360\0\0\0\n\7\0\10\7\377\377\377\377\360p\240"
+"\17\360\11\15\17\367\0\300O\360\240\17\17\371\14\0o\377\377\377\377\0\0\0\10"
+"\6\0\6\6\377\377\377\360\200\17\370\13\17\360\240\357\360\15\17\377\377\377"
+"\0\11\11\0\7\11\377\377\377\360\364\0\220\360\360p\14\360\366\n\0\360\360\220"
+"\300\360\360\14\4\360\371\0\340\360\360\300\6\360\377\377\377\360\0\0\0\n\10"
+"\0\10\10\377\377\377\377\360\200\260\17\360\13\16\17\370\0\320_\360\260\5\17"
+"\372\16\0\177\360\320P\17\377\377\377\377\0\0\0\10\7\0\6\7\377\377\377\360\240"
+"\17\371\14\17\360\300\377\360\16\17\374\0o\377\377\377\0\0";
+const uint16_t font-4bpp_length = 3552;
@@ -0,0 +1,52 @@
+#include <stdint.h>
+/* autogenerated file.  Do not edit
+Font name: font-v2-wide
+Character set : AZaz09 U+00E9U+4E00-U+4E07U+4E10
+Pixel sizes : 10 
+*/
+
+const uint8_t font-v2-wide[] = {
+
+0x46, 0x4f, 0x4e, 0x54, 0x66, 0x6f, 0x6e, 0x74, 0x2d, 0x76, 0x32, 0x2d, 0x77, 0x69, 0x64, 0x65, 
+0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x01, 0x02, 0x00, 0x00, 0x02, 0xa0, 0x00, 0x00, 0x00, 0x00, 
+0x00, 0x00, 0x02, 0x80, 0x0a, 0x0c, 0x0a, 0x0a, 0x02, 0x01, 0x00, 0x00, 0x00, 0x20, 0x00, 0x00, 
+0x00, 0x20, 0x00, 0x00, 0x00, 0xa0, 0x00, 0x00, 0x00, 0x30, 0x00, 0x00, 0x00, 0x30, 0x00, 0x00, 
+0x00, 0xb0, 0x00, 0x00, 0x00, 0x39, 0x00, 0x00, 0x00, 0x39, 0x00, 0x00, 0x00, 0xc0, 0x00, 0x00, 
+0x00, 0x41, 0x00, 0x00, 0x00, 0x41, 0x00, 0x00, 0x00, 0xe0, 0x00, 0x00, 0x00, 0x5a, 0x00, 0x00, 
+0x00, 0x5a, 0x00, 0x00, 0x01, 0x00, 0x00, 0x00, 0x00, 0x61, 0x00, 0x00, 0x00, 0x61, 0x00, 0x00, 
+0x01, 0x20, 0x00, 0x00, 0x00, 0x7a, 0x00, 0x00, 0x00, 0x7a, 0x00, 0x00, 0x01, 0x40, 0x00, 0x00, 
+0x00, 0xe9, 0x00, 0x00, 0x00, 0xe9, 0x00, 0x00, 0x01, 0x60, 0x00, 0x00, 0x4e, 0x00, 0x00, 0x00, 
+0x4e, 0x07, 0x00, 0x00, 0x01, 0x80, 0x00, 0x00, 0x01, 0xa0, 0x00, 0x00, 0x01, 0xc0, 0x00, 0x00, 
+0x01, 0xe0, 0x00, 0x00, 0x01, 0xf0, 0x00, 0x00, 0x02, 0x10, 0x00, 0x00, 0x02, 0x30, 0x00, 0x00, 
+0x02, 0x50, 0x00, 0x00, 0x4e, 0x10, 0x00, 0x00, 0x4e, 0x10, 0x00, 0x00, 0x02, 0x60, 0x00, 0x00, 
+0x09, 0x0a, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 
+0x08, 0x05, 0x00, 0x06, 0x05, 0xff, 0xf0, 0xd2, 0x30, 0xc8, 0xb0, 0xc2, 0x30, 0xff, 0xf0, 0x00, 
+0x07, 0x07, 0x00, 0x05, 0x07, 0xff, 0xc0, 0xc8, 0xc0, 0xe3, 0xc0, 0xcc, 0xc0, 0xc1, 0xc0, 0xf0, 
+0xc0, 0xff, 0xc0, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 
+0x09, 0x07, 0x00, 0x07, 0x07, 0xff, 0xfc, 0xd2, 0x0c, 0xc4, 0x8c, 0xc2, 0x3c, 0xd0, 0xcc, 0xc8, 
+0x1c, 0xff, 0xfc, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 
+0x07, 0x06, 0x00, 0x05, 0x06, 0xff, 0xc0, 0xcc, 0xc0, 0xc1, 0xc0, 0xd0, 0xc0, 0xc4, 0xc0, 0xff, 
+0xc0, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 
+0x08, 0x07, 0x00, 0x06, 0x07, 0xff, 0xf0, 0xc8, 0x30, 0xd2, 0x30, 0xc8, 0xf0, 0xc3, 0x30, 0xe0, 
+0x70, 0xff, 0xf0, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 
+0x09, 0x06, 0x00, 0x07, 0x06, 0xff, 0xfc, 0xd1, 0x0c, 0xc4, 0x8c, 0xc2, 0x3c, 0xd0, 0x8c, 0xff, 
+0xfc, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 
+0x09, 0x07, 0x00, 0x07, 0x07, 0xff, 0xfc, 0xc8, 0xcc, 0xc3, 0x1c, 0xe0, 0x4c, 0xcc, 0x1c, 0xf1, 
+0x0c, 0xff, 0xfc, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 
+0x07, 0x08, 0x00, 0x05, 0x0a, 0xff, 0xc0, 0xe3, 0xc0, 0xcc, 0xc0, 0xc1, 0xc0, 0xf0, 0xc0, 0xc4, 
+0xc0, 0xd1, 0xc0, 0xc4, 0xc0, 0xc2, 0xc0, 0xff, 0xc0, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 
+0x08, 0x07, 0x00, 0x06, 0x07, 0xff, 0xf0, 0xe0, 0x70, 0xcc, 0x30, 0xf1, 0x30, 0xc4, 0xb0, 0xc2, 
+0x30, 0xff, 0xf0, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 
+0x09, 0x06, 0x00, 0x07, 0x06, 0xff, 0xfc, 0xc4, 0x8c, 0xc1, 0x2c, 0xd0, 0x8c, 0xc4, 0x2c, 0xff, 
+0xfc, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 
+0x07, 0x05, 0x00, 0x05, 0x05, 0xff, 0xc0, 0xc4, 0xc0, 0xd2, 0xc0, 0xc8, 0xc0, 0xff, 0xc0, 0x00, 
+0x08, 0x08, 0x00, 0x06, 0x08, 0xff, 0xf0, 0xf0, 0x70, 0xc4, 0x30, 0xd1, 0x30, 0xc4, 0xb0, 0xc2, 
+0x30, 0xd0, 0xb0, 0xff, 0xf0, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 
+0x09, 0x07, 0x00, 0x07, 0x07, 0xff, 0xfc, 0xc4, 0x8c, 0xc2, 0x2c, 0xd0, 0x8c, 0xc8, 0x3c, 0xe2, 
+0x0c, 0xff, 0xfc, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 
+0x07, 0x06, 0x00, 0x05, 0x06, 0xff, 0xc0, 0xc4, 0xc0, 0xd2, 0xc0, 0xc8, 0xc0, 0xc2, 0xc0, 0xff, 
+0xc0, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 
+0x08, 0x05, 0x00, 0x06, 0x05, 0xff, 0xf0, 0xc2, 0x30, 0xe0, 0xf0, 0xc8, 0x30, 0xff, 0xf0, 0x00, 
+0x08, 0x08, 0x00, 0x06, 0x08, 0xff, 0xf0, 0xc3, 0x30, 0xe0, 0x70, 0xcc, 0x30, 0xf1, 0x30, 0xc4, 
+0xb0, 0xc2, 0x30, 0xff, 0xf0, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, };
+const uint16_t font-v2-wide_length = 672;